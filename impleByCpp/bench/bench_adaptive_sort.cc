@@ -0,0 +1,79 @@
+#include "core_api/array_utils.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// adaptive_sort / 自底向上归并 / std::stable_sort 在不同有序程度输入上的对比
+// range(1): 输入分布, 0 随机 1 有序 2 逆序 3 锯齿 4 少量不同值 5 有序+尾部追加
+// 用法: ./bench_adaptive_sort --benchmark_filter=Adaptive
+
+static std::vector<int> make_input(std::size_t n, int kind) {
+  std::mt19937 rng(2024);
+  std::vector<int> list(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    switch (kind) {
+    case 1:
+      list[i] = static_cast<int>(i);
+      break;
+    case 2:
+      list[i] = static_cast<int>(n - i);
+      break;
+    case 3:
+      list[i] = static_cast<int>(i % 4096);
+      break;
+    case 4:
+      list[i] = static_cast<int>(rng() % 8);
+      break;
+    case 5:
+      list[i] = i < n - n / 32 ? static_cast<int>(i)
+                               : static_cast<int>(rng() % n);
+      break;
+    default:
+      list[i] = static_cast<int>(rng());
+    }
+  }
+  return list;
+}
+
+template <typename Sort>
+static void run(benchmark::State &state, Sort sort) {
+  const auto input = make_input(state.range(0), state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto list = input;
+    state.ResumeTiming();
+    sort(list);
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_AdaptiveSort(benchmark::State &state) {
+  run(state, [](std::vector<int> &list) {
+    ArrayUtils::adaptive_sort(list.begin(), list.end());
+  });
+}
+
+static void BM_BottomUpMergeSort(benchmark::State &state) {
+  run(state, [](std::vector<int> &list) {
+    ArrayUtils::parallel_merge_sort(list.begin(), list.end(), std::less<>(),
+                                    {.threads = 1});
+  });
+}
+
+static void BM_StdStableSort(benchmark::State &state) {
+  run(state, [](std::vector<int> &list) {
+    std::stable_sort(list.begin(), list.end());
+  });
+}
+
+#define ADAPTIVE_ARGS                                                          \
+  ArgsProduct({{1 << 16, 1 << 22}, {0, 1, 2, 3, 4, 5}})                        \
+      ->Unit(benchmark::kMillisecond)
+
+BENCHMARK(BM_AdaptiveSort)->ADAPTIVE_ARGS;
+BENCHMARK(BM_BottomUpMergeSort)->ADAPTIVE_ARGS;
+BENCHMARK(BM_StdStableSort)->ADAPTIVE_ARGS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+#include "core_api/array_utils.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <queue>
+#include <random>
+#include <vector>
+
+// d叉堆: 不同叉数的堆排序与 std::sort_heap 对比; 优先队列与 std::priority_queue 对比
+// range(0): 元素个数
+// 用法: ./bench_heap --benchmark_filter=HeapSort
+
+static std::vector<int> random_ints(std::size_t n) {
+  std::mt19937 rng(2024);
+  std::vector<int> list(n);
+  for (auto &x : list)
+    x = static_cast<int>(rng());
+  return list;
+}
+
+template <std::size_t Arity> static void BM_HeapSort(benchmark::State &state) {
+  const auto input = random_ints(state.range(0));
+  for (auto _ : state) {
+    auto list = input;
+    ArrayUtils::heap_sort<Arity>(list.begin(), list.end());
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdSortHeap(benchmark::State &state) {
+  const auto input = random_ints(state.range(0));
+  for (auto _ : state) {
+    auto list = input;
+    std::make_heap(list.begin(), list.end());
+    std::sort_heap(list.begin(), list.end());
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// 调度器式负载: 堆保持 range(0) 个元素, 反复取出堆顶并放回一个更晚的时间点
+static void BM_PriorityQueue(benchmark::State &state) {
+  const auto input = random_ints(state.range(0));
+  for (auto _ : state) {
+    ArrayUtils::PriorityQueue<int, std::greater<>> queue(input.begin(),
+                                                         input.end());
+    for (std::size_t i = 0; i < input.size(); ++i)
+      queue.replace_top(queue.top() + input[i] % 1024 + 1);
+    benchmark::DoNotOptimize(queue.top());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdPriorityQueue(benchmark::State &state) {
+  const auto input = random_ints(state.range(0));
+  for (auto _ : state) {
+    std::priority_queue<int, std::vector<int>, std::greater<>> queue(
+        input.begin(), input.end());
+    for (std::size_t i = 0; i < input.size(); ++i) {
+      int next = queue.top() + input[i] % 1024 + 1;
+      queue.pop();
+      queue.push(next);
+    }
+    benchmark::DoNotOptimize(queue.top());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_HeapSort<2>)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_HeapSort<4>)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_HeapSort<8>)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_StdSortHeap)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_PriorityQueue)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_StdPriorityQueue)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+
+BENCHMARK_MAIN();
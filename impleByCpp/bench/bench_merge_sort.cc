@@ -0,0 +1,70 @@
+#include "core_api/array_utils.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// 串行 merge_sort / 并行 parallel_merge_sort / std::sort 对比
+// 用法: ./bench_merge_sort --benchmark_filter=Parallel
+
+static std::vector<int> random_input(std::size_t n) {
+  std::mt19937 rng(2024);
+  std::vector<int> list(n);
+  for (auto &x : list)
+    x = static_cast<int>(rng());
+  return list;
+}
+
+static void BM_SerialMergeSort(benchmark::State &state) {
+  const auto input = random_input(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto list = input;
+    state.ResumeTiming();
+    ArrayUtils::merge_sort(list, 0, static_cast<int>(list.size()) - 1);
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_StdSort(benchmark::State &state) {
+  const auto input = random_input(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto list = input;
+    state.ResumeTiming();
+    std::sort(list.begin(), list.end());
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// range(1): 线程数
+static void BM_ParallelMergeSort(benchmark::State &state) {
+  const auto input = random_input(state.range(0));
+  ArrayUtils::ThreadPool pool(state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto list = input;
+    state.ResumeTiming();
+    ArrayUtils::parallel_merge_sort(list.begin(), list.end(), std::less<>(),
+                                    {}, pool);
+    benchmark::DoNotOptimize(list.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SerialMergeSort)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 24)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StdSort)
+    ->RangeMultiplier(8)
+    ->Range(1 << 16, 1 << 24)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelMergeSort)
+    ->ArgsProduct({{1 << 20, 1 << 24, 100'000'000}, {1, 2, 4, 8, 16, 32}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+#include "core_api/array_utils.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <queue>
+#include <random>
+#include <span>
+#include <vector>
+
+// 败者树多路归并 multiway_merge 与 std::priority_queue 实现的对比
+// 总元素数固定, range(0): 路数 k
+// 用法: ./bench_multiway_merge --benchmark_filter=LoserTree
+
+static constexpr std::size_t kTotal = 1 << 22;
+
+static std::vector<std::vector<int>> sorted_runs(std::size_t k) {
+  std::mt19937 rng(2024);
+  std::vector<std::vector<int>> runs(k);
+  for (std::size_t i = 0; i < kTotal; ++i)
+    runs[rng() % k].push_back(static_cast<int>(rng()));
+  for (auto &run : runs)
+    std::sort(run.begin(), run.end());
+  return runs;
+}
+
+static void BM_LoserTreeMerge(benchmark::State &state) {
+  const auto runs = sorted_runs(state.range(0));
+  std::vector<std::span<const int>> spans(runs.begin(), runs.end());
+  std::vector<int> out(kTotal);
+  for (auto _ : state) {
+    ArrayUtils::multiway_merge<int>(
+        std::span<const std::span<const int>>(spans), out.begin());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kTotal);
+}
+
+static void BM_PriorityQueueMerge(benchmark::State &state) {
+  const auto runs = sorted_runs(state.range(0));
+  std::vector<int> out(kTotal);
+  using Entry = std::pair<int, std::size_t>; // (键, 路号)
+  for (auto _ : state) {
+    std::vector<std::size_t> pos(runs.size(), 0);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> heap;
+    for (std::size_t i = 0; i < runs.size(); ++i)
+      if (!runs[i].empty())
+        heap.emplace(runs[i][0], i);
+    auto it = out.begin();
+    while (!heap.empty()) {
+      auto [key, i] = heap.top();
+      heap.pop();
+      *it++ = key;
+      if (++pos[i] < runs[i].size())
+        heap.emplace(runs[i][pos[i]], i);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kTotal);
+}
+
+BENCHMARK(BM_LoserTreeMerge)
+    ->RangeMultiplier(2)
+    ->Range(2, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PriorityQueueMerge)
+    ->RangeMultiplier(2)
+    ->Range(2, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
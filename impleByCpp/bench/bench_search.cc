@@ -0,0 +1,236 @@
+#include "core_api/search_utils.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+// 有序数组查找: Eytzinger 索引、静态B+树、学习型索引、批量交错查找、16路向量查找
+// 与 std::lower_bound、binarySearch 对比; *Timestamps 为近似等间隔的时间戳键
+// 线性查找: simd_find 与 std::find 对比
+// range(0): 元素个数; 每轮执行 kQueries 次随机查询
+// 用法: ./bench_search --benchmark_filter=Eytzinger
+
+constexpr std::size_t kQueries = 1 << 16;
+
+static std::vector<int> sorted_ints(std::size_t n) {
+  std::mt19937 rng(2024);
+  std::vector<int> list(n);
+  for (auto &x : list)
+    x = static_cast<int>(rng() >> 1);
+  std::sort(list.begin(), list.end());
+  return list;
+}
+
+static std::vector<int> random_queries() {
+  std::mt19937 rng(7);
+  std::vector<int> queries(kQueries);
+  for (auto &q : queries)
+    q = static_cast<int>(rng() >> 1);
+  return queries;
+}
+
+// 每步间隔1~4, 模拟按时间顺序写入的时间戳
+static std::vector<int> timestamp_ints(std::size_t n) {
+  std::mt19937 rng(2025);
+  std::vector<int> list(n);
+  int t = 0;
+  for (auto &x : list)
+    x = t += 1 + static_cast<int>(rng() % 4);
+  return list;
+}
+
+static std::vector<int> timestamp_queries(int max_value) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist(0, max_value);
+  std::vector<int> queries(kQueries);
+  for (auto &q : queries)
+    q = dist(rng);
+  return queries;
+}
+
+static void BM_StdLowerBound(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const auto queries = random_queries();
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int q : queries)
+      sum += std::lower_bound(list.begin(), list.end(), q) - list.begin();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_BinarySearch(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const auto queries = random_queries();
+  for (auto _ : state) {
+    int sum = 0;
+    for (int q : queries)
+      sum += binarySearch(list, q);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_Eytzinger(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const SearchUtils::EytzingerIndex<int> index(list);
+  const auto queries = random_queries();
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int q : queries)
+      sum += index.lower_bound(q);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_BatchLowerBound(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const auto queries = random_queries();
+  std::vector<std::size_t> out(kQueries);
+  for (auto _ : state) {
+    SearchUtils::lower_bound_batch(list, queries, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_BatchBinarySearch(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const auto queries = random_queries();
+  std::vector<int> out(kQueries);
+  for (auto _ : state) {
+    binarySearch(list, queries, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_SimdLowerBound(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const auto queries = random_queries();
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int q : queries)
+      sum += SearchUtils::simd_lower_bound(list.data(), list.size(), q);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_StaticBTree(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const SearchUtils::StaticBTree tree(list);
+  const auto queries = random_queries();
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int q : queries)
+      sum += tree.lower_bound(q);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_PgmIndex(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  const SearchUtils::PgmIndex<int> index(list);
+  const auto queries = random_queries();
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int q : queries)
+      sum += index.lower_bound(q);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+  state.counters["index_bytes"] = static_cast<double>(index.size_in_bytes());
+}
+
+static void BM_PgmIndexTimestamps(benchmark::State &state) {
+  const auto list = timestamp_ints(state.range(0));
+  const SearchUtils::PgmIndex<int> index(list);
+  const auto queries = timestamp_queries(list.back());
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int q : queries)
+      sum += index.lower_bound(q);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+  state.counters["index_bytes"] = static_cast<double>(index.size_in_bytes());
+}
+
+static void BM_StdLowerBoundTimestamps(benchmark::State &state) {
+  const auto list = timestamp_ints(state.range(0));
+  const auto queries = timestamp_queries(list.back());
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int q : queries)
+      sum += std::lower_bound(list.begin(), list.end(), q) - list.begin();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+static void BM_InterpolationTimestamps(benchmark::State &state) {
+  const auto list = timestamp_ints(state.range(0));
+  const auto queries = timestamp_queries(list.back());
+  for (auto _ : state) {
+    int sum = 0;
+    for (int q : queries)
+      sum += interpolationSearch(list, q);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * kQueries);
+}
+
+// 目标取自数组中随机位置, 平均扫描一半元素
+static void BM_SimdFind(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  std::mt19937 rng(9);
+  std::vector<int> targets(1024);
+  for (auto &t : targets)
+    t = list[rng() % list.size()];
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int t : targets)
+      sum += SearchUtils::simd_find(list.data(), list.size(), t);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * targets.size());
+}
+
+static void BM_StdFind(benchmark::State &state) {
+  const auto list = sorted_ints(state.range(0));
+  std::mt19937 rng(9);
+  std::vector<int> targets(1024);
+  for (auto &t : targets)
+    t = list[rng() % list.size()];
+  for (auto _ : state) {
+    std::size_t sum = 0;
+    for (int t : targets)
+      sum += std::find(list.begin(), list.end(), t) - list.begin();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * targets.size());
+}
+
+BENCHMARK(BM_StdLowerBound)->RangeMultiplier(16)->Range(1 << 4, 1 << 26);
+BENCHMARK(BM_BinarySearch)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_Eytzinger)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_BatchLowerBound)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_BatchBinarySearch)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_StaticBTree)->RangeMultiplier(16)->Range(1 << 4, 1 << 26);
+BENCHMARK(BM_PgmIndex)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_PgmIndexTimestamps)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_StdLowerBoundTimestamps)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_InterpolationTimestamps)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_SimdLowerBound)->RangeMultiplier(16)->Range(1 << 4, 1 << 26);
+BENCHMARK(BM_SimdFind)->RangeMultiplier(4)->Range(1 << 4, 1 << 14);
+BENCHMARK(BM_StdFind)->RangeMultiplier(4)->Range(1 << 4, 1 << 14);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,326 @@
+#include "core_api/array_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// 排序基准: arrayImple.cc 中的全部排序(及 std::sort / std::stable_sort 作参照)
+// 在 6 种输入分布、16 ~ 1亿 个元素上的表现
+// 每个基准输出:
+//   per_element  每个元素耗时
+//   comparisons  每个元素的比较次数 (额外一轮插桩运行, 见 utils/sort_stats.h, 不计入耗时;
+//                非比较排序及没有泛型版本的排序无此项)
+//   moves        每个元素的移动/拷贝次数 (同上)
+//   max_depth    最大递归深度/归并层数 (同上, 仅限调用了 note_depth 的排序)
+//   allocations  排序内部堆分配次数 (同上, 仅限调用了 note_allocation 的排序)
+//   peak_bytes   排序过程中堆内存峰值 (相对排序开始时), 取该基准全部运行中的最大值,
+//                benchmark 只报告最后一次运行, 首次运行中分配后被保留的缓冲区也能计入
+// 用法:
+//   ./bench_sorts --benchmark_filter='random/.*/65536'
+//   ./bench_sorts --max_size=100000000            # 默认只跑到 1<<20
+//   ./bench_sorts --benchmark_out=sorts.json --benchmark_out_format=json
+// 基准名为 <分布>/<排序>/<元素个数>, JSON 结果可直接用 benchmark 自带的 compare.py 做回归对比
+
+// ---------------------------------------------------------------------------
+// 堆内存统计: 替换全局 operator new/delete, 记录当前占用与峰值
+namespace {
+std::atomic<std::size_t> g_heap_current{0};
+std::atomic<std::size_t> g_heap_peak{0};
+
+void *note_alloc(void *p) {
+  if (p == nullptr)
+    throw std::bad_alloc();
+  const std::size_t now =
+      g_heap_current.fetch_add(malloc_usable_size(p)) + malloc_usable_size(p);
+  std::size_t peak = g_heap_peak.load(std::memory_order_relaxed);
+  while (now > peak && !g_heap_peak.compare_exchange_weak(peak, now))
+    ;
+  return p;
+}
+
+// 替换后的 operator new 就是 malloc, GCC 内联后会误报 new/free 不匹配
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void note_free(void *p) {
+  if (p == nullptr)
+    return;
+  g_heap_current.fetch_sub(malloc_usable_size(p));
+  std::free(p);
+}
+#pragma GCC diagnostic pop
+} // namespace
+
+void *operator new(std::size_t n) { return note_alloc(std::malloc(n ? n : 1)); }
+void *operator new(std::size_t n, std::align_val_t align) {
+  const auto a = static_cast<std::size_t>(align);
+  return note_alloc(std::aligned_alloc(a, (n + a - 1) / a * a));
+}
+void operator delete(void *p) noexcept { note_free(p); }
+void operator delete(void *p, std::size_t) noexcept { note_free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { note_free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+  note_free(p);
+}
+
+namespace {
+// 插桩运行: 泛型排序以计数比较器和计数元素运行一次, 得到比较/移动/深度/分配统计
+template <auto Sort>
+ArrayUtils::SortStats measure(const std::vector<int> &values) {
+  return ArrayUtils::measure_sort(values, Sort);
+}
+
+// ---------------------------------------------------------------------------
+// 输入分布
+enum class Distribution { random, sorted, reversed, few_unique, zipfian, organ_pipe };
+
+constexpr Distribution kDistributions[] = {
+    Distribution::random,     Distribution::sorted,  Distribution::reversed,
+    Distribution::few_unique, Distribution::zipfian, Distribution::organ_pipe};
+
+const char *name_of(Distribution d) {
+  switch (d) {
+  case Distribution::random:
+    return "random";
+  case Distribution::sorted:
+    return "sorted";
+  case Distribution::reversed:
+    return "reversed";
+  case Distribution::few_unique:
+    return "few_unique";
+  case Distribution::zipfian:
+    return "zipfian";
+  case Distribution::organ_pipe:
+    return "organ_pipe";
+  }
+  return "";
+}
+
+std::vector<int> generate(Distribution d, std::size_t n) {
+  std::mt19937_64 rng(2024);
+  std::vector<int> list(n);
+  switch (d) {
+  case Distribution::random:
+    for (auto &x : list)
+      x = static_cast<int>(rng());
+    break;
+  case Distribution::sorted:
+    for (std::size_t i = 0; i < n; ++i)
+      list[i] = static_cast<int>(i);
+    break;
+  case Distribution::reversed:
+    for (std::size_t i = 0; i < n; ++i)
+      list[i] = static_cast<int>(n - i);
+    break;
+  case Distribution::few_unique: // 16 个不同值
+    for (auto &x : list)
+      x = static_cast<int>(rng() % 16);
+    break;
+  case Distribution::zipfian: { // s = 1, 值域不超过 2^20, 按累积分布表反查
+    const std::size_t values = std::clamp<std::size_t>(n, 1, 1 << 20);
+    std::vector<double> cdf(values);
+    double sum = 0;
+    for (std::size_t k = 0; k < values; ++k)
+      cdf[k] = sum += 1.0 / static_cast<double>(k + 1);
+    std::uniform_real_distribution<double> unit(0.0, sum);
+    for (auto &x : list)
+      x = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), unit(rng)) -
+                           cdf.begin());
+    break;
+  }
+  case Distribution::organ_pipe: // 先升后降
+    for (std::size_t i = 0; i < n; ++i)
+      list[i] = static_cast<int>(std::min(i, n - 1 - i));
+    break;
+  }
+  return list;
+}
+
+// 同一分布/规模的基准连续注册, 只缓存最近一次生成的输入即可
+const std::vector<int> &input_for(Distribution d, std::size_t n) {
+  static Distribution cached_d = Distribution::random;
+  static std::size_t cached_n = 0;
+  static std::vector<int> cached;
+  if (cached_n != n || cached_d != d) {
+    cached = generate(d, n);
+    cached_d = d;
+    cached_n = n;
+  }
+  return cached;
+}
+
+// ---------------------------------------------------------------------------
+// 被测排序
+struct SortEntry {
+  const char *name;
+  std::size_t max_size; // 平方级排序只跑小规模
+  void (*run)(std::vector<int> &);
+  // 对应泛型版本的插桩运行, 没有则为空
+  ArrayUtils::SortStats (*measure)(const std::vector<int> &);
+  // 泛型版本上报了哪些统计(kReportsDepth / kReportsAllocations), 未上报的不输出,
+  // 以免把"没有测量"显示成0
+  unsigned reports = 0;
+};
+
+constexpr unsigned kReportsDepth = 1;
+constexpr unsigned kReportsAllocations = 2;
+
+constexpr std::size_t kQuadraticMax = 1 << 14;
+constexpr std::size_t kUnbounded = ~std::size_t(0);
+
+const SortEntry kSorts[] = {
+    {"bubble_sort", kQuadraticMax, ArrayUtils::bubble_sort, nullptr},
+    {"opt_bubble_sort", kQuadraticMax, ArrayUtils::opt_bubble_sort, nullptr},
+    {"selection_sort", kQuadraticMax, ArrayUtils::selection_sort, nullptr},
+    {"insertion_sort", kQuadraticMax, ArrayUtils::insertion_sort, nullptr},
+    {"shell_sort", 1 << 20, ArrayUtils::shell_sort, nullptr},
+    {"quick_sort_hoare", kUnbounded,
+     [](std::vector<int> &v) {
+       ArrayUtils::quick_sort(v, 0, static_cast<int>(v.size()) - 1,
+                              ArrayUtils::PartitionScheme::hoare);
+     },
+     measure<[](auto first, auto last, auto comp) {
+       ArrayUtils::introsort(first, last, comp,
+                             ArrayUtils::PartitionScheme::hoare);
+     }>,
+     kReportsDepth},
+    {"quick_sort_simd", kUnbounded,
+     [](std::vector<int> &v) {
+       ArrayUtils::quick_sort(v, 0, static_cast<int>(v.size()) - 1,
+                              ArrayUtils::PartitionScheme::simd);
+     },
+     nullptr}, // 向量化分区只对 int/float 生效, 计数类型上与 hoare 相同
+    {"quick_sort_block", kUnbounded,
+     [](std::vector<int> &v) {
+       ArrayUtils::quick_sort(v, 0, static_cast<int>(v.size()) - 1,
+                              ArrayUtils::PartitionScheme::block);
+     },
+     measure<[](auto first, auto last, auto comp) {
+       ArrayUtils::introsort(first, last, comp,
+                             ArrayUtils::PartitionScheme::block);
+     }>,
+     kReportsDepth},
+    {"heap_sort", kUnbounded, ArrayUtils::heap_sort,
+     measure<[](auto first, auto last, auto comp) {
+       ArrayUtils::heap_sort(first, last, comp);
+     }>},
+    {"merge_sort", kUnbounded,
+     [](std::vector<int> &v) {
+       ArrayUtils::merge_sort(v, 0, static_cast<int>(v.size()) - 1);
+     },
+     nullptr},
+    {"adaptive_sort", kUnbounded,
+     [](std::vector<int> &v) { ArrayUtils::adaptive_sort(v.begin(), v.end()); },
+     measure<[](auto first, auto last, auto comp) {
+       ArrayUtils::adaptive_sort(first, last, comp);
+     }>,
+     kReportsDepth | kReportsAllocations},
+    {"count_sort", kUnbounded,
+     [](std::vector<int> &v) { ArrayUtils::count_sort(v); }, nullptr},
+    {"bucket_sort", kUnbounded, ArrayUtils::bucket_sort, nullptr},
+    {"radix_sort", kUnbounded, ArrayUtils::radix_sort, nullptr},
+    {"std_sort", kUnbounded,
+     [](std::vector<int> &v) { std::sort(v.begin(), v.end()); },
+     measure<[](auto first, auto last, auto comp) {
+       std::sort(first, last, comp);
+     }>},
+    {"std_stable_sort", kUnbounded,
+     [](std::vector<int> &v) { std::stable_sort(v.begin(), v.end()); },
+     measure<[](auto first, auto last, auto comp) {
+       std::stable_sort(first, last, comp);
+     }>},
+};
+
+// 小规模时一次迭代排序多份拷贝, 使计时远大于时钟开销
+constexpr std::size_t kBatchElements = 1 << 16;
+
+void run_sort(benchmark::State &state, const SortEntry &sort, Distribution d,
+              std::size_t n, std::size_t &peak) {
+  const auto &input = input_for(d, n);
+  const std::size_t batch = std::max<std::size_t>(1, kBatchElements / n);
+  std::vector<std::vector<int>> lists(batch);
+  for (auto _ : state) {
+    for (auto &list : lists)
+      list = input;
+    const std::size_t base = g_heap_current.load();
+    g_heap_peak.store(base);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto &list : lists)
+      sort.run(list);
+    const auto stop = std::chrono::steady_clock::now();
+    peak = std::max(peak, g_heap_peak.load() - base);
+    state.SetIterationTime(std::chrono::duration<double>(stop - start).count());
+    benchmark::DoNotOptimize(lists.front().data());
+  }
+  if (!std::is_sorted(lists.front().begin(), lists.front().end()))
+    state.SkipWithError("result is not sorted");
+
+  const auto elements = static_cast<double>(batch * n);
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch * n));
+  state.counters["per_element"] = benchmark::Counter(
+      elements, benchmark::Counter::kIsIterationInvariantRate |
+                    benchmark::Counter::kInvert);
+  state.counters["peak_bytes"] = static_cast<double>(peak);
+  if (sort.measure != nullptr) {
+    const auto stats = sort.measure(input);
+    const auto per = [n](std::size_t x) {
+      return static_cast<double>(x) / static_cast<double>(n);
+    };
+    state.counters["comparisons"] = per(stats.comparisons);
+    state.counters["moves"] = per(stats.moves);
+    if (sort.reports & kReportsDepth)
+      state.counters["max_depth"] = static_cast<double>(stats.max_depth);
+    if (sort.reports & kReportsAllocations)
+      state.counters["allocations"] = static_cast<double>(stats.allocations);
+  }
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::size_t max_size = 1 << 20;
+  // 取出本程序自己的参数, 其余交给 benchmark
+  int kept = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--max_size=", 11) == 0)
+      max_size = std::strtoull(argv[i] + 11, nullptr, 10);
+    else
+      argv[kept++] = argv[i];
+  }
+  argc = kept;
+
+  const std::size_t sizes[] = {16,      256,     4096,      1 << 16,
+                               1 << 20, 1 << 24, 100000000};
+  for (Distribution d : kDistributions)
+    for (std::size_t n : sizes) {
+      if (n > max_size)
+        continue;
+      for (const SortEntry &sort : kSorts) {
+        if (n > sort.max_size)
+          continue;
+        const std::string name = std::string(name_of(d)) + "/" + sort.name +
+                                 "/" + std::to_string(n);
+        benchmark::RegisterBenchmark(
+            name.c_str(),
+            [&sort, d, n, peak = std::make_shared<std::size_t>(0)](
+                benchmark::State &state) {
+              run_sort(state, sort, d, n, *peak);
+            })
+            ->UseManualTime()
+            ->Unit(benchmark::kMicrosecond);
+      }
+    }
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
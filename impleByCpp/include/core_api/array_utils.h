@@ -1,6 +1,21 @@
 #ifndef ARRAY_UTILS_H
 #define ARRAY_UTILS_H
 // 主要引入数组实现的线性表
+#include "utils/adaptive_sort.h"
+#include "utils/block_partition.h"
+#include "utils/bucket_sort.h"
+#include "utils/counting_sort.h"
+#include "utils/dary_heap.h"
+#include "utils/external_sort.h"
+#include "utils/introsort.h"
+#include "utils/merge_sort.h"
+#include "utils/multiway_merge.h"
+#include "utils/radix_sort.h"
+#include "utils/sample_sort.h"
+#include "utils/selection.h"
+#include "utils/sort_by_key.h"
+#include "utils/top_k.h"
+#include <span>
 #include <vector>
 
 namespace ArrayUtils {
@@ -8,18 +23,21 @@ void printList(const std::vector<int> &list);
 void bubble_sort(std::vector<int> &list);    // 冒泡排序
 void selection_sort(std::vector<int> &list); // 选择排序
 int partition(std::vector<int> &list, const int &low, const int &high);
-void quick_sort(std::vector<int> &list, const int &low,
-                const int &high);            // 快速排序
+void quick_sort(std::vector<int> &list, const int &low, const int &high,
+                PartitionScheme scheme = PartitionScheme::simd); // 快速排序
 void insertion_sort(std::vector<int> &list); // 插入排序
 void heapify(std::vector<int> &list, const int &n, const int &i);
 void heap_sort(std::vector<int> &list); // 堆排序
 void merge(std::vector<int> &list, const int &left, const int &mid,
            const int &right);
+void merge(std::vector<int> &list, const int &left, const int &mid,
+           const int &right, std::span<int> buf);
 void merge_sort(std::vector<int> &list, const int &left,
                 const int &right);       // 归并排序
 void shell_sort(std::vector<int> &list); // 希尔排序
 void count_sort(std::vector<int> &list, const int &min_val,
                 const int &max_val);          // 计数排序
+void count_sort(std::vector<int> &list);      // 计数排序(自动值域)
 void bucket_sort(std::vector<int> &list);     // 桶排序
 void radix_sort(std::vector<int> &list);      // 基数排序
 void opt_bubble_sort(std::vector<int> &list); // 优化的冒泡排序
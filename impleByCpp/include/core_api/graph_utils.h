@@ -1,6 +1,7 @@
 #ifndef GRAPH_UTILS_H
 #define GRAPH_UTILS_H
 
+#include <functional>
 #include <map>
 #include <stack>
 #include <utility>
@@ -20,6 +21,8 @@
 const char NULL_VERTEX = '#';
 typedef char VertexType;
 typedef int EdgeType;
+// 遍历访问器: 按访问顺序对每个顶点调用, 遍历本身不输出任何内容
+typedef std::function<void(const VertexType &)> VertexVisitor;
 
 namespace common_graph_utils {
 struct Edge {
@@ -58,7 +61,7 @@ public:
   void deleteEdge(const VertexType &src, const VertexType &dest);
   void connectedComponent();
   // BFS有点过于简单,直接按序读行,故不实现
-  void DFS(const VertexType &start);
+  void DFS(const VertexType &start, const VertexVisitor &visit);
   void unionSet(std::vector<int> &parent, int v1, int v2, bool check);
   void printMST(const std::pair<std::vector<Edge>, int> &mstEdges);
   bool isEdge(const VertexType &src, const VertexType &dest);
@@ -117,9 +120,10 @@ public:
   void printGraph();
   void printCycle(const std::vector<VertexType> &cycle);
   void DFS_recursive_util(const VertexType &current,
-                          std::vector<bool> &visited);
+                          std::vector<bool> &visited,
+                          const VertexVisitor &visit = {});
   void fillOrder(VertexType v, std::stack<VertexType> &stack);
-  void topologicalSort();
+  std::vector<VertexType> topologicalSort();
   bool
   initGraph(std::vector<VertexType> &vertexList,
             std::map<std::pair<VertexType, VertexType>, EdgeType> &edgeList);
@@ -128,13 +132,14 @@ public:
   bool addVertex(const VertexType &vertex);
   bool deleteEdge(const VertexType &src, const VertexType &dest);
   bool deleteVertex(const VertexType &vertex);
-  bool DFS(const VertexType &start);
-  bool DFS_recursive(const VertexType &start);
-  bool BFS(const VertexType &start);
+  bool DFS(const VertexType &start, const VertexVisitor &visit);
+  bool DFS_recursive(const VertexType &start, const VertexVisitor &visit);
+  bool BFS(const VertexType &start, const VertexVisitor &visit);
   bool isEdge(const VertexType &src, const VertexType &dest);
   bool isCyclicDFS(const VertexType &current);
   bool isVertex(const VertexType &vertex);
   bool is_cyclic();
+  const std::vector<std::vector<VertexType>> &getCycles() const;
   EdgeType getEdgeWeight(const VertexType &src, const VertexType &dest);
 };
 } // namespace directed_graph_utils
@@ -1,11 +1,21 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include "utils/batch_search.h"
+#include "utils/eytzinger.h"
+#include "utils/learned_index.h"
+#include "utils/simd_search.h"
+#include "utils/static_btree.h"
+#include <span>
 #include <vector>
 
 int linearSearch(const std::vector<int> &arr, const int &target);
 int binarySearch(const std::vector<int> &arr, const int &target);
+void binarySearch(const std::vector<int> &arr, std::span<const int> targets,
+                  std::span<int> out);
 int fibonacciSearch(const std::vector<int> &arr, const int &target);
 int interpolationSearch(const std::vector<int> &arr, const int &target);
+int interpolationSearch(const SearchUtils::PgmIndex<int> &index,
+                        const int &target);
 
 #endif
\ No newline at end of file
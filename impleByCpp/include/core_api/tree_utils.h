@@ -1,6 +1,8 @@
 #ifndef TREE_UTILS_H
 #define TREE_UTILS_H
 
+#include "utils/log.h"
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -23,7 +25,7 @@ typedef struct TreeNode {
       delete left;
     if (right)
       delete right;
-    std::cout << "delete node " << val << std::endl;
+    log_utils::log("delete node ", val);
   }
 } BTreeNode;
 
@@ -39,7 +41,8 @@ build_tree_from_preorder_inorder(const std::vector<NodeVal> &preorder,
 BTreeNode *
 build_tree_from_inorder_postorder(const std::vector<NodeVal> &inorder,
                                   const std::vector<NodeVal> &postorder);
-bool levelorderTraversal(BTreeNode *root);
+bool levelorderTraversal(BTreeNode *root,
+                         const std::function<void(BTreeNode *)> &visit);
 
 int height(BTreeNode *root);
 int width(BTreeNode *root);
@@ -103,21 +106,33 @@ bool is_valid_bst(T *root, T *minNode = nullptr, T *maxNode = nullptr) {
          is_valid_bst(root->right, root, maxNode);
 }
 
+/**
+ * @brief 打印访问器: 遍历时输出节点值, 需要打印时显式传给遍历函数
+ */
+struct PrintVisitor {
+  template <typename T> void operator()(const T *node) const {
+    std::cout << node->val << " ";
+  }
+};
+
 /**
  * @brief pre order traversal of a binary tree.
  *
  * @tparam T
+ * @tparam Visit 形如 void(T *) 的访问器, 按遍历顺序对每个节点调用
  * @param root
+ * @param visit
  * @return true traversed successfully.
  * @return false empty tree.
  */
-template <typename T> bool preorderTraversal(T *root) {
+template <typename T, typename Visit>
+bool preorderTraversal(T *root, Visit &&visit) {
   if (is_empty(root)) {
     return false;
   }
-  std::cout << root->val << " ";
-  preorderTraversal(root->left);
-  preorderTraversal(root->right);
+  visit(root);
+  preorderTraversal(root->left, visit);
+  preorderTraversal(root->right, visit);
   return true;
 }
 
@@ -125,17 +140,20 @@ template <typename T> bool preorderTraversal(T *root) {
  * @brief inoreder traversal of a binary tree.
  *
  * @tparam T
+ * @tparam Visit
  * @param root
+ * @param visit
  * @return true
  * @return false
  */
-template <typename T> bool inorderTraversal(T *root) {
+template <typename T, typename Visit>
+bool inorderTraversal(T *root, Visit &&visit) {
   if (is_empty(root)) {
     return false;
   }
-  inorderTraversal(root->left);
-  std::cout << root->val << " ";
-  inorderTraversal(root->right);
+  inorderTraversal(root->left, visit);
+  visit(root);
+  inorderTraversal(root->right, visit);
   return true;
 }
 
@@ -143,17 +161,20 @@ template <typename T> bool inorderTraversal(T *root) {
  * @brief post order traversal of a binary tree.
  *
  * @tparam T
+ * @tparam Visit
  * @param root
+ * @param visit
  * @return true
  * @return false
  */
-template <typename T> bool postorderTraversal(T *root) {
+template <typename T, typename Visit>
+bool postorderTraversal(T *root, Visit &&visit) {
   if (is_empty(root)) {
     return false;
   }
-  postorderTraversal(root->left);
-  postorderTraversal(root->right);
-  std::cout << root->val << " ";
+  postorderTraversal(root->left, visit);
+  postorderTraversal(root->right, visit);
+  visit(root);
   return true;
 }
 
@@ -161,11 +182,14 @@ template <typename T> bool postorderTraversal(T *root) {
  * @brief pre order traversal of a binary tree without recursion.
  *
  * @tparam T
+ * @tparam Visit
  * @param root
+ * @param visit
  * @return true
  * @return false
  */
-template <typename T> bool norecursion_preorderTraversal(T *root) {
+template <typename T, typename Visit>
+bool norecursion_preorderTraversal(T *root, Visit &&visit) {
   if (is_empty(root)) {
     return false;
   }
@@ -174,7 +198,7 @@ template <typename T> bool norecursion_preorderTraversal(T *root) {
   while (!s.empty()) {
     T *node = s.top();
     s.pop();
-    std::cout << node->val << " ";
+    visit(node);
     if (node->right) {
       s.push(node->right);
     }
@@ -189,11 +213,14 @@ template <typename T> bool norecursion_preorderTraversal(T *root) {
  * @brief inorder traversal of a binary tree without recursion.
  *
  * @tparam T
+ * @tparam Visit
  * @param root
+ * @param visit
  * @return true
  * @return false
  */
-template <typename T> bool norecursion_inorderTraversal(T *root) {
+template <typename T, typename Visit>
+bool norecursion_inorderTraversal(T *root, Visit &&visit) {
   if (is_empty(root)) {
     return false;
   }
@@ -206,7 +233,7 @@ template <typename T> bool norecursion_inorderTraversal(T *root) {
     } else {
       node = s.top();
       s.pop();
-      std::cout << node->val << " ";
+      visit(node);
       node = node->right;
     }
   }
@@ -217,11 +244,14 @@ template <typename T> bool norecursion_inorderTraversal(T *root) {
  * @brief post order traversal of a binary tree without recursion.
  *
  * @tparam T
+ * @tparam Visit
  * @param root
+ * @param visit
  * @return true
  * @return false
  */
-template <typename T> bool norecursion_postorderTraversal(T *root) {
+template <typename T, typename Visit>
+bool norecursion_postorderTraversal(T *root, Visit &&visit) {
   if (is_empty(root)) {
     return false;
   }
@@ -239,7 +269,7 @@ template <typename T> bool norecursion_postorderTraversal(T *root) {
     }
   }
   while (!s2.empty()) {
-    std::cout << s2.top()->val << " ";
+    visit(s2.top());
     s2.pop();
   }
   return true;
@@ -0,0 +1,312 @@
+#pragma once
+// 自适应稳定归并排序(powersort): 识别输入中已有的升序/严格降序段(run),
+// 短段补齐到 minrun(二分插入; int/float 升序时用排序网络), 再按 powersort 策略决定归并顺序, 归并时使用 galloping
+// 已有序/逆序输入 O(n), 由少量有序段拼接的输入 O(n log(段数))
+#include "utils/introsort.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::ptrdiff_t kMinGallop = 7; // 连续胜出多少次后进入 galloping
+
+/**
+ * @brief 计算 minrun: 使 n / minrun 接近且不超过2的幂, 取值范围 [32, 64]
+ */
+inline std::ptrdiff_t compute_minrun(std::ptrdiff_t n) {
+  std::ptrdiff_t r = 0;
+  while (n >= 64) {
+    r |= n & 1;
+    n >>= 1;
+  }
+  return n + r;
+}
+
+/**
+ * @brief 从 first 开始识别一个run, 严格降序的run原地翻转为升序(保持稳定)
+ *
+ * @return RandomIt run的尾后位置
+ */
+template <typename RandomIt, typename Compare>
+RandomIt count_run(RandomIt first, RandomIt last, Compare &comp) {
+  RandomIt cur = first + 1;
+  if (cur == last)
+    return cur;
+  if (comp(*cur, *first)) {
+    while (++cur != last && comp(*cur, *(cur - 1)))
+      ;
+    std::reverse(first, cur);
+  } else {
+    while (++cur != last && !comp(*cur, *(cur - 1)))
+      ;
+  }
+  return cur;
+}
+
+/**
+ * @brief 二分插入排序, [first, sorted) 已有序
+ */
+template <typename RandomIt, typename Compare>
+void binary_insertion_sort(RandomIt first, RandomIt sorted, RandomIt last,
+                           Compare &comp) {
+  for (RandomIt cur = sorted; cur != last; ++cur) {
+    RandomIt pos = std::upper_bound(first, cur, *cur, comp);
+    if (pos == cur)
+      continue;
+    auto key = std::move(*cur);
+    std::move_backward(pos, cur, cur + 1);
+    *pos = std::move(key);
+  }
+}
+
+/**
+ * @brief 从前端指数探测的 partition_point: [first, p) 满足 before, [p, last) 不满足
+ * 结果靠近 first 时只需 O(log(p - first)) 次比较
+ */
+template <typename It, typename Pred>
+It gallop_front(It first, It last, Pred before) {
+  const std::ptrdiff_t n = last - first;
+  std::ptrdiff_t lo = 0, hi = 1;
+  while (hi <= n && before(*(first + (hi - 1)))) {
+    lo = hi;
+    hi = 2 * hi + 1;
+  }
+  return std::partition_point(first + lo, first + std::min(hi - 1, n),
+                              before);
+}
+
+/**
+ * @brief 从后端指数探测的 partition_point, 结果靠近 last 时代价小
+ */
+template <typename It, typename Pred>
+It gallop_back(It first, It last, Pred before) {
+  const std::ptrdiff_t n = last - first;
+  std::ptrdiff_t lo = 0, hi = 1;
+  while (hi <= n && !before(*(last - hi))) {
+    lo = hi;
+    hi = 2 * hi + 1;
+  }
+  return std::partition_point(first + (n - std::min(hi - 1, n)), last - lo,
+                              before);
+}
+
+/**
+ * @brief 左段较短: 左段移入 buf, 从前往后归并回 dest
+ */
+template <typename RandomIt, typename BufIt, typename Compare>
+void merge_lo(RandomIt dest, std::ptrdiff_t na, RandomIt b, RandomIt b_end,
+              BufIt buf, std::ptrdiff_t &min_gallop, Compare &comp) {
+  BufIt a = buf, a_end = std::move(dest, dest + na, buf);
+  RandomIt out = dest;
+  while (a != a_end && b != b_end) {
+    std::ptrdiff_t wins_a = 0, wins_b = 0;
+    while (a != a_end && b != b_end) {
+      if (comp(*b, *a)) {
+        *out++ = std::move(*b++);
+        wins_a = 0;
+        if (++wins_b >= min_gallop)
+          break;
+      } else {
+        *out++ = std::move(*a++);
+        wins_b = 0;
+        if (++wins_a >= min_gallop)
+          break;
+      }
+    }
+    while (a != a_end && b != b_end) {
+      // 左段中不大于 *b 的元素整体输出, 右段中小于 *a 的元素整体输出
+      BufIt a_stop =
+          gallop_front(a, a_end, [&](const auto &x) { return !comp(*b, x); });
+      const std::ptrdiff_t ka = a_stop - a;
+      out = std::move(a, a_stop, out);
+      a = a_stop;
+      if (a == a_end)
+        break;
+      RandomIt b_stop =
+          gallop_front(b, b_end, [&](const auto &x) { return comp(x, *a); });
+      const std::ptrdiff_t kb = b_stop - b;
+      out = std::move(b, b_stop, out);
+      b = b_stop;
+      if (b == b_end)
+        break;
+      if (ka < kMinGallop && kb < kMinGallop) {
+        ++min_gallop; // 数据交错, galloping 不划算, 提高进入门槛
+        break;
+      }
+      if (min_gallop > 1)
+        --min_gallop;
+    }
+  }
+  std::move(a, a_end, out); // 右段剩余元素已在原位
+}
+
+/**
+ * @brief 右段较短: 右段移入 buf, 从后往前归并
+ */
+template <typename RandomIt, typename BufIt, typename Compare>
+void merge_hi(RandomIt a_first, RandomIt a_last, std::ptrdiff_t nb, BufIt buf,
+              std::ptrdiff_t &min_gallop, Compare &comp) {
+  RandomIt out = a_last + nb;
+  BufIt b_first = buf, b_last = std::move(a_last, out, buf);
+  while (a_first != a_last && b_first != b_last) {
+    std::ptrdiff_t wins_a = 0, wins_b = 0;
+    while (a_first != a_last && b_first != b_last) {
+      if (comp(*(b_last - 1), *(a_last - 1))) {
+        *--out = std::move(*--a_last);
+        wins_b = 0;
+        if (++wins_a >= min_gallop)
+          break;
+      } else {
+        *--out = std::move(*--b_last);
+        wins_a = 0;
+        if (++wins_b >= min_gallop)
+          break;
+      }
+    }
+    while (a_first != a_last && b_first != b_last) {
+      // 左段中大于 b 末尾的元素整体输出, 右段中不小于 a 末尾的元素整体输出
+      RandomIt a_stop = gallop_back(a_first, a_last, [&](const auto &x) {
+        return !comp(*(b_last - 1), x);
+      });
+      const std::ptrdiff_t ka = a_last - a_stop;
+      out = std::move_backward(a_stop, a_last, out);
+      a_last = a_stop;
+      if (a_first == a_last)
+        break;
+      BufIt b_stop = gallop_back(b_first, b_last, [&](const auto &x) {
+        return comp(x, *(a_last - 1));
+      });
+      const std::ptrdiff_t kb = b_last - b_stop;
+      out = std::move_backward(b_stop, b_last, out);
+      b_last = b_stop;
+      if (b_first == b_last)
+        break;
+      if (ka < kMinGallop && kb < kMinGallop) {
+        ++min_gallop;
+        break;
+      }
+      if (min_gallop > 1)
+        --min_gallop;
+    }
+  }
+  std::move_backward(b_first, b_last, out); // 左段剩余元素已在原位
+}
+
+/**
+ * @brief 稳定合并相邻有序段 [first, mid) 与 [mid, last), buf 不短于较短的一段
+ * 先裁掉两端已在最终位置的元素, 再选择较短的一段放入缓冲区
+ */
+template <typename RandomIt, typename BufIt, typename Compare>
+void merge_runs(RandomIt first, RandomIt mid, RandomIt last, BufIt buf,
+                std::ptrdiff_t &min_gallop, Compare &comp) {
+  first = gallop_front(first, mid, [&](const auto &x) { return !comp(*mid, x); });
+  if (first == mid)
+    return;
+  last = gallop_back(mid, last,
+                     [&](const auto &x) { return comp(x, *(mid - 1)); });
+  if (mid == last)
+    return;
+  if (mid - first <= last - mid)
+    merge_lo(first, mid - first, mid, last, buf, min_gallop, comp);
+  else
+    merge_hi(first, mid, last - mid, buf, min_gallop, comp);
+}
+
+/**
+ * @brief powersort 中相邻两段 [s1, s1 + n1), [s1 + n1, s1 + n1 + n2) 分界的"深度"
+ * 即两段中点在 [0, n) 上按二分逐层细分时首次被分开的层数
+ */
+inline int node_power(std::ptrdiff_t s1, std::ptrdiff_t n1, std::ptrdiff_t n2,
+                      std::ptrdiff_t n) {
+  int power = 0;
+  std::ptrdiff_t a = 2 * s1 + n1; // 左段中点的2倍
+  std::ptrdiff_t b = a + n1 + n2; // 右段中点的2倍
+  while (true) {
+    ++power;
+    if (a >= n) {
+      a -= n;
+      b -= n;
+    } else if (b >= n) {
+      break;
+    }
+    a <<= 1;
+    b <<= 1;
+  }
+  return power;
+}
+} // namespace detail
+
+/**
+ * @brief 自适应稳定排序(powersort + galloping 归并)
+ * 辅助缓冲区最多 n/2 个元素, 首次归并时分配一次; 值类型需可默认构造
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param comp
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void adaptive_sort(RandomIt first, RandomIt last, Compare comp = Compare{}) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  const std::ptrdiff_t n = last - first;
+  if (n < 2)
+    return;
+  const std::ptrdiff_t minrun = detail::compute_minrun(n);
+
+  struct Run {
+    std::ptrdiff_t base, len;
+    int power; // 与下一个run分界的深度
+  };
+  std::vector<Run> stack;
+  stack.reserve(2 * std::bit_width(static_cast<std::size_t>(n)));
+  std::vector<T> buffer;
+  std::ptrdiff_t min_gallop = detail::kMinGallop;
+  auto merge_top = [&] {
+    Run right = stack.back();
+    stack.pop_back();
+    Run &left = stack.back();
+    if (static_cast<std::ptrdiff_t>(buffer.size()) <
+        std::min(left.len, right.len)) {
+      buffer.resize(n / 2);
+      detail::note_allocation(comp, buffer.size() * sizeof(T));
+    }
+    detail::merge_runs(first + left.base, first + right.base,
+                       first + right.base + right.len, buffer.begin(),
+                       min_gallop, comp);
+    left.len += right.len;
+  };
+
+  for (std::ptrdiff_t lo = 0; lo < n;) {
+    RandomIt run_end = detail::count_run(first + lo, last, comp);
+    std::ptrdiff_t len = run_end - (first + lo);
+    if (len < minrun) {
+      const std::ptrdiff_t forced = std::min(minrun, n - lo);
+      // int/float 升序时相等元素不可区分, 可直接用排序网络(minrun <= kSmallSortMax)
+      if constexpr (detail::kHasSmallSort<RandomIt, Compare>)
+        detail::small_range_sort(first + lo, first + lo + forced, comp);
+      else
+        detail::binary_insertion_sort(first + lo, run_end,
+                                      first + lo + forced, comp);
+      len = forced;
+    }
+    if (!stack.empty()) {
+      Run &top = stack.back();
+      int power = detail::node_power(top.base, top.len, len, n);
+      while (stack.size() > 1 && stack[stack.size() - 2].power > power)
+        merge_top();
+      stack.back().power = power;
+    }
+    stack.push_back({lo, len, 0});
+    detail::note_depth(comp, stack.size()); // 待归并run栈深度即归并树深度
+    lo += len;
+  }
+  while (stack.size() > 1)
+    merge_top();
+}
+} // namespace ArrayUtils
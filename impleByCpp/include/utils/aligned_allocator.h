@@ -0,0 +1,43 @@
+#pragma once
+// 按缓存行(或更大粒度)对齐的分配器, 静态查找结构用它保证节点/预取块不跨缓存行
+#include <cstddef>
+#include <new>
+
+namespace SearchUtils {
+namespace detail {
+inline constexpr std::size_t kCacheLine = 64;
+
+/**
+ * @brief 起始地址按 Align 字节对齐的分配器
+ *
+ * @tparam T
+ * @tparam Align 对齐字节数, 需为2的幂且不小于 alignof(T)
+ */
+template <typename T, std::size_t Align = kCacheLine> struct AlignedAllocator {
+  using value_type = T;
+  static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0);
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Align>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+
+  T *allocate(std::size_t n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{Align}));
+  }
+
+  void deallocate(T *p, std::size_t) {
+    ::operator delete(p, std::align_val_t{Align});
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Align> &) const {
+    return true;
+  }
+};
+} // namespace detail
+} // namespace SearchUtils
@@ -0,0 +1,82 @@
+#pragma once
+// 批量二分查找: 一组查询交错推进, 让多个缓存未命中同时在途(访存级并行)
+// 逐个查找时每一步都要等上一次访存返回; 这里一组 kBatchGroup 个查询同步下降,
+// 每个查询走完一步后立即预取它下一步要读的位置, 等轮到它时数据已在缓存中
+// 所有查询在同一数组上二分, 步数相同, 因此可以按步同步推进, 每步用条件传送代替分支
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+
+namespace SearchUtils {
+namespace detail {
+inline constexpr std::size_t kBatchGroup = 16; // 同时在途的查询数
+
+/**
+ * @brief 交错下降的 lower_bound 内核, 不分配内存
+ *
+ * @param data 有序数组
+ * @param n
+ * @param keys 查询
+ * @param m
+ * @param comp
+ * @param emit 以 (查询序号, 第一个不小于该查询的元素下标) 调用
+ */
+template <typename T, typename Key, typename Compare, typename Emit>
+void interleaved_lower_bound(const T *data, std::size_t n, const Key *keys,
+                             std::size_t m, Compare &comp, Emit &&emit) {
+  std::size_t base[kBatchGroup];
+  for (std::size_t start = 0; start < m; start += kBatchGroup) {
+    const std::size_t count = std::min(kBatchGroup, m - start);
+    const Key *group = keys + start;
+    if (n == 0) {
+      for (std::size_t i = 0; i < count; ++i)
+        emit(start + i, std::size_t(0));
+      continue;
+    }
+    std::fill_n(base, count, 0);
+    std::size_t len = n;
+    while (len > 1) {
+      const std::size_t half = len / 2;
+      const std::size_t next_half = (len - half) / 2;
+      for (std::size_t i = 0; i < count; ++i) {
+        // 用乘法而不是三目运算, 否则编译器会生成条件跳转
+        base[i] += half * static_cast<std::size_t>(
+                              comp(data[base[i] + half - 1], group[i]));
+        __builtin_prefetch(data + base[i] +
+                           (next_half > 0 ? next_half - 1 : 0));
+      }
+      len -= half;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+      emit(start + i, base[i] + (comp(data[base[i]], group[i]) ? 1 : 0));
+  }
+}
+} // namespace detail
+
+/**
+ * @brief 批量 lower_bound: out[i] 为 sorted 中第一个不小于 keys[i] 的元素下标,
+ * 不存在时为 sorted.size()
+ *
+ * @tparam Sorted 连续存储的有序序列
+ * @tparam Keys 连续存储的查询序列, 无需有序
+ * @tparam Compare
+ * @param sorted
+ * @param keys
+ * @param out 结果, 长度不小于 keys 的长度
+ * @param comp
+ */
+template <std::ranges::contiguous_range Sorted,
+          std::ranges::contiguous_range Keys, typename Compare = std::less<>>
+void lower_bound_batch(const Sorted &sorted, const Keys &keys,
+                       std::span<std::size_t> out, Compare comp = Compare{}) {
+  assert(out.size() >= std::ranges::size(keys));
+  detail::interleaved_lower_bound(
+      std::ranges::data(sorted), std::ranges::size(sorted),
+      std::ranges::data(keys), std::ranges::size(keys), comp,
+      [out](std::size_t i, std::size_t pos) { out[i] = pos; });
+}
+} // namespace SearchUtils
@@ -0,0 +1,73 @@
+#pragma once
+// 块分区(BlockQuicksort): 先把一个块内"放错一侧"的元素偏移量写入缓冲区,
+// 再成批交换; 扫描阶段只有无分支的计数累加, 随机数据下几乎没有分支预测失败
+// 不依赖SIMD, 适用于任意类型与比较器
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::ptrdiff_t kPartitionBlockSize = 64; // 偏移缓冲区大小
+} // namespace detail
+
+/**
+ * @brief 按谓词原地分区(不稳定): 满足 pred 的元素移到前部
+ *
+ * @tparam RandomIt
+ * @tparam Predicate
+ * @param first
+ * @param last
+ * @param pred
+ * @return RandomIt 分界点: [first, p) 满足 pred, [p, last) 不满足
+ */
+template <typename RandomIt, typename Predicate>
+RandomIt block_partition(RandomIt first, RandomIt last, Predicate pred) {
+  constexpr std::ptrdiff_t B = detail::kPartitionBlockSize;
+  unsigned char offsets_l[B], offsets_r[B];
+  std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+  // 不变式: [first, l) 满足 pred, [r, last) 不满足; 未交换完的块仍在 [l, r) 内
+  RandomIt l = first, r = last;
+  while (r - l > 2 * B) {
+    if (num_l == 0) {
+      start_l = 0;
+      for (std::ptrdiff_t i = 0; i < B; ++i) {
+        offsets_l[num_l] = static_cast<unsigned char>(i);
+        num_l += !pred(*(l + i));
+      }
+    }
+    if (num_r == 0) {
+      start_r = 0;
+      for (std::ptrdiff_t i = 0; i < B; ++i) {
+        offsets_r[num_r] = static_cast<unsigned char>(i);
+        num_r += !!pred(*(r - 1 - i));
+      }
+    }
+    const std::ptrdiff_t num = std::min(num_l, num_r);
+    for (std::ptrdiff_t k = 0; k < num; ++k)
+      std::iter_swap(l + offsets_l[start_l + k], r - 1 - offsets_r[start_r + k]);
+    num_l -= num;
+    num_r -= num;
+    start_l += num;
+    start_r += num;
+    if (num_l == 0)
+      l += B;
+    if (num_r == 0)
+      r -= B;
+  }
+
+  // 剩余不超过两个块, 用普通的双指针收尾
+  while (true) {
+    while (l < r && pred(*l))
+      ++l;
+    while (l < r && !pred(*(r - 1)))
+      --r;
+    if (l >= r)
+      return l;
+    std::iter_swap(l, r - 1);
+    ++l;
+    --r;
+  }
+}
+} // namespace ArrayUtils
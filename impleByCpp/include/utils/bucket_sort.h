@@ -0,0 +1,148 @@
+#pragma once
+// 桶排序: 面向大致均匀分布的键(如 [0,1) 浮点数、哈希值)
+// 元素先映射为 [0, 2^bits) 上保序的整数"位置", 再分两级分桶:
+//   1. 粗桶: 桶数使每个桶约等于L2容量, 分发时写入流少, 对缓存/TLB友好
+//   2. 细桶: 每个粗桶在L2内再分为平均约16个元素的细桶, 细桶交给排序网络
+// 两级都用计数 + 前缀和把桶排布在一块连续数组里, 不使用 vector<vector>
+#include "utils/introsort.h"
+#include "utils/radix_sort.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::size_t kBucketL2Bytes = std::size_t(256) << 10; // 粗桶大小
+inline constexpr std::size_t kMaxCoarseBuckets = std::size_t(1) << 14;
+inline constexpr std::size_t kFineBucketSize = 16; // 细桶平均元素数
+
+/**
+ * @brief 对已排布好的一段桶逐个排序
+ */
+template <typename T>
+void sort_buckets(T *data, const std::vector<std::size_t> &begin) {
+  std::less<> comp;
+  for (std::size_t b = 0; b + 1 < begin.size(); ++b) {
+    T *lo = data + begin[b], *hi = data + begin[b + 1];
+    if (hi - lo <= static_cast<std::ptrdiff_t>(kSmallSortMax))
+      small_range_sort(lo, hi, comp);
+    else
+      introsort(lo, hi, comp, PartitionScheme::simd);
+  }
+}
+
+/**
+ * @brief 计数分发: 按 bucket_of 把 [src, src + n) 稳定地分到 dst, 返回各桶起点(末尾为 n)
+ */
+template <typename T, typename BucketOf>
+std::vector<std::size_t> distribute(T *src, std::size_t n, T *dst,
+                                    std::size_t buckets, BucketOf bucket_of) {
+  std::vector<std::size_t> begin(buckets + 1, 0);
+  for (std::size_t i = 0; i < n; ++i)
+    ++begin[bucket_of(src[i]) + 1];
+  for (std::size_t b = 0; b < buckets; ++b)
+    begin[b + 1] += begin[b];
+  std::vector<std::size_t> offset(begin.begin(), begin.end() - 1);
+  for (std::size_t i = 0; i < n; ++i)
+    dst[offset[bucket_of(src[i])]++] = std::move(src[i]);
+  return begin;
+}
+
+/**
+ * @brief 两级分桶排序, rank 为 T -> [0, 2^bits) 的保序映射
+ */
+template <typename T, typename Rank>
+void bucket_sort_ranked(T *data, std::size_t n, unsigned bits, Rank rank_of) {
+  // 64位全范围的键先丢掉最低位, 保证后续移位量小于64
+  const unsigned drop = bits > 63 ? bits - 63 : 0;
+  bits -= drop;
+  auto rank = [&](const T &x) { return rank_of(x) >> drop; };
+
+  const std::size_t coarse = std::clamp<std::size_t>(
+      std::bit_floor(n * sizeof(T) / kBucketL2Bytes), 1, kMaxCoarseBuckets);
+  const unsigned log_coarse =
+      std::min<unsigned>(std::bit_width(coarse) - 1, bits);
+  const unsigned shift1 = bits - log_coarse;
+
+  auto buffer = std::make_unique_for_overwrite<T[]>(n);
+  const auto coarse_begin =
+      distribute(data, n, buffer.get(), std::size_t(1) << log_coarse,
+                 [&](const T &x) { return rank(x) >> shift1; });
+
+  for (std::size_t c = 0; c + 1 < coarse_begin.size(); ++c) {
+    T *src = buffer.get() + coarse_begin[c];
+    T *dst = data + coarse_begin[c];
+    const std::size_t m = coarse_begin[c + 1] - coarse_begin[c];
+    const unsigned log_fine = std::min<unsigned>(
+        std::bit_width(m / kFineBucketSize), shift1);
+    const unsigned shift2 = shift1 - log_fine;
+    const std::uint64_t mask = (std::uint64_t(1) << log_fine) - 1;
+    const auto fine_begin =
+        distribute(src, m, dst, std::size_t(1) << log_fine,
+                   [&](const T &x) { return (rank(x) >> shift2) & mask; });
+    sort_buckets(dst, fine_begin);
+  }
+}
+} // namespace detail
+
+/**
+ * @brief 桶排序(不稳定), 适用于整数与浮点数, 键越接近均匀分布越快
+ * 桶边界按实际的最小/最大值确定, 无需调用方给出范围; 浮点数不支持NaN
+ * 需要 n 个元素的辅助空间
+ *
+ * @tparam ContiguousIt 连续存储迭代器, 元素为算术类型
+ * @param first
+ * @param last
+ */
+template <std::contiguous_iterator ContiguousIt>
+  requires std::is_arithmetic_v<std::iter_value_t<ContiguousIt>>
+void bucket_sort(ContiguousIt first, ContiguousIt last) {
+  using T = std::iter_value_t<ContiguousIt>;
+  T *data = std::to_address(first);
+  const auto n = static_cast<std::size_t>(last - first);
+  std::less<> comp;
+  if (n <= kSmallSortMax) {
+    detail::small_range_sort(data, data + n, comp);
+    return;
+  }
+  auto [min_it, max_it] = std::minmax_element(data, data + n);
+  const T lo = *min_it, hi = *max_it;
+  if (!comp(lo, hi))
+    return;
+
+  if constexpr (std::is_integral_v<T>) {
+    using Traits = RadixTraits<T>;
+    const auto base = Traits::encode(lo);
+    const auto range = static_cast<std::uint64_t>(Traits::encode(hi) - base);
+    detail::bucket_sort_ranked(
+        data, n, static_cast<unsigned>(std::bit_width(range)),
+        [base](T x) {
+          return static_cast<std::uint64_t>(RadixTraits<T>::encode(x) - base);
+        });
+  } else {
+    // 线性缩放到 [0, 2^32), 对 [0,1) 均匀分布的浮点数各桶大小均衡
+    constexpr unsigned bits = 32;
+    constexpr std::uint64_t top = (std::uint64_t(1) << bits) - 1;
+    const double base = static_cast<double>(lo);
+    const double scale =
+        std::ldexp(1.0, bits) / (static_cast<double>(hi) - base);
+    if (!std::isfinite(scale) || scale == 0) {
+      introsort(data, data + n, comp, PartitionScheme::simd);
+      return;
+    }
+    detail::bucket_sort_ranked(data, n, bits, [base, scale, top](T x) {
+      return std::min(
+          static_cast<std::uint64_t>((static_cast<double>(x) - base) * scale),
+          top);
+    });
+  }
+}
+} // namespace ArrayUtils
@@ -0,0 +1,137 @@
+#pragma once
+// 计数排序(自动值域): 一次 min/max 遍历(int 走向量化内核)确定值域,
+// 值域相对 n 较小时做计数排序, 否则交给LSD基数排序
+// 元素本身就是键, 统计完直方图后按值原地回填, 不需要输出数组也没有整体拷贝
+// 并行版本: 每块独立直方图再求和, 回填按输出位置切分给各线程
+#include "utils/radix_sort.h"
+#include "utils/simd_sort.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::size_t kCountingRangeFactor = 2; // 值域 <= 2n 时计数
+inline constexpr std::size_t kCountingSmallRange = std::size_t(1) << 16; // 值域不超过此值时总是计数
+inline constexpr std::size_t kCountingMaxRange = std::size_t(1) << 28;
+
+template <std::integral T>
+std::pair<T, T> minmax_of(const T *data, std::size_t n) {
+  if constexpr (std::same_as<T, int>) {
+    return simd_minmax(data, n);
+  } else {
+    auto [lo, hi] = std::minmax_element(data, data + n);
+    return {*lo, *hi};
+  }
+}
+
+/**
+ * @brief 按直方图原地回填 [data, data + n): 值 lo + v 出现 count[v] 次
+ * 按输出位置切成 blocks 段, 每段二分找到起始值后独立填写;
+ * blocks 为1时在当前线程填写, 不使用线程池(此时 pool 可以为空)
+ */
+template <std::integral T>
+void fill_from_histogram(T *data, std::size_t n, T lo,
+                         std::vector<std::size_t> &count, std::size_t blocks,
+                         ThreadPool *pool = nullptr) {
+  // count 变为各值的结束位置(前缀和)
+  std::size_t sum = 0;
+  for (auto &c : count)
+    c = sum += c;
+  auto fill_block = [&](std::size_t t) {
+    std::size_t pos = n * t / blocks, end = n * (t + 1) / blocks;
+    auto v = static_cast<std::size_t>(
+        std::upper_bound(count.begin(), count.end(), pos) - count.begin());
+    while (pos < end) {
+      std::size_t stop = std::min(count[v], end);
+      std::fill(data + pos, data + stop,
+                static_cast<T>(lo + static_cast<T>(v)));
+      pos = stop;
+      ++v;
+    }
+  };
+  if (blocks <= 1)
+    fill_block(0);
+  else
+    pool->parallel_for(blocks, fill_block);
+}
+} // namespace detail
+
+/**
+ * @brief 计数排序, 值域自动检测; 值域过大时自动改用基数排序
+ *
+ * @tparam ContiguousIt 连续存储迭代器, 元素为整数
+ * @param first
+ * @param last
+ * @param options 并发度与任务粒度, 默认串行
+ * @param pool 执行所用线程池; 为空且需要并行时使用全局线程池, 串行时不创建线程池
+ */
+template <std::contiguous_iterator ContiguousIt>
+  requires std::integral<std::iter_value_t<ContiguousIt>>
+void counting_sort(ContiguousIt first, ContiguousIt last,
+                   const ParallelSortOptions &options = {.threads = 1},
+                   ThreadPool *pool = nullptr) {
+  using T = std::iter_value_t<ContiguousIt>;
+  T *data = std::to_address(first);
+  const auto n = static_cast<std::size_t>(last - first);
+  if (n < 2)
+    return;
+  const auto [lo, hi] = detail::minmax_of(data, n);
+  // 先比较跨度 hi - lo 而不是值域 hi - lo + 1: 64位整数的全跨度加一会回绕成0
+  const auto span = static_cast<std::uint64_t>(RadixTraits<T>::encode(hi) -
+                                               RadixTraits<T>::encode(lo));
+  if (span == 0)
+    return;
+  if (pool == nullptr && options.threads != 1)
+    pool = &ThreadPool::instance();
+  if (span >= detail::kCountingMaxRange ||
+      (span >= detail::kCountingSmallRange &&
+       span >= detail::kCountingRangeFactor * n)) {
+    if (pool == nullptr)
+      radix_sort(first, last);
+    else
+      parallel_radix_sort(first, last, options, *pool);
+    return;
+  }
+  const auto range = static_cast<std::size_t>(span) + 1;
+
+  std::size_t threads = pool == nullptr ? 1
+                        : options.threads == 0
+                            ? pool->size()
+                            : std::min(options.threads, pool->size());
+  const std::size_t grain = std::max<std::size_t>(options.grain, 1);
+  // 每块一份直方图, 直方图总量不超过 n, 以免值域较大时统计比排序本身还贵
+  const std::size_t blocks = std::max<std::size_t>(
+      std::min({threads, n / grain, std::max<std::size_t>(n / range, 1)}), 1);
+
+  std::vector<std::size_t> count(range, 0);
+  auto index = [lo](T x) {
+    return static_cast<std::size_t>(RadixTraits<T>::encode(x) -
+                                    RadixTraits<T>::encode(lo));
+  };
+  if (blocks == 1) {
+    for (std::size_t i = 0; i < n; ++i)
+      ++count[index(data[i])];
+  } else {
+    std::vector<std::size_t> local(blocks * range, 0);
+    pool->parallel_for(blocks, [&](std::size_t t) {
+      std::size_t *h = local.data() + t * range;
+      for (std::size_t i = n * t / blocks; i < n * (t + 1) / blocks; ++i)
+        ++h[index(data[i])];
+    });
+    pool->parallel_for(blocks, [&](std::size_t t) {
+      for (std::size_t v = range * t / blocks; v < range * (t + 1) / blocks;
+           ++v)
+        for (std::size_t b = 0; b < blocks; ++b)
+          count[v] += local[b * range + v];
+    });
+  }
+  detail::fill_from_histogram(data, n, lo, count, blocks, pool);
+}
+} // namespace ArrayUtils
@@ -0,0 +1,267 @@
+#pragma once
+// d叉堆(默认4叉): 同一节点的子节点连续存放, 树高为 log_d(n), 下沉时访存次数少
+// 下沉采用 Floyd 自底向上策略: 先沿较大子节点一路走到叶子(不与被下沉元素比较),
+// 再从叶子向上找到插入位置; 堆排序中被下沉的元素来自堆尾, 通常很快就停住, 比较次数更少
+// 下沉时预取孙节点所在的缓存行
+// PriorityQueue 的存储按缓存行对齐, 使每组子节点不跨缓存行
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::size_t kCacheLine = 64;
+
+template <std::size_t Arity> constexpr std::ptrdiff_t first_child(std::ptrdiff_t i) {
+  return static_cast<std::ptrdiff_t>(Arity) * i + 1;
+}
+
+template <std::size_t Arity> constexpr std::ptrdiff_t parent_of(std::ptrdiff_t i) {
+  return (i - 1) / static_cast<std::ptrdiff_t>(Arity);
+}
+
+/**
+ * @brief 在 [child, child + count) 中找按 comp 最大的子节点
+ */
+template <typename RandomIt, typename Compare>
+std::ptrdiff_t best_child(RandomIt first, std::ptrdiff_t child,
+                          std::size_t count, Compare &comp) {
+  std::ptrdiff_t best = child;
+  for (std::size_t k = 1; k < count; ++k) {
+    const std::ptrdiff_t c = child + static_cast<std::ptrdiff_t>(k);
+    if (comp(*(first + best), *(first + c)))
+      best = c;
+  }
+  return best;
+}
+
+/**
+ * @brief 上浮(大顶堆): 把 value 从空穴 hole 向上移动, 不越过 top
+ */
+template <std::size_t Arity, typename RandomIt, typename Compare, typename T>
+void dary_sift_up(RandomIt first, std::ptrdiff_t hole, std::ptrdiff_t top,
+                  T &&value, Compare &comp) {
+  while (hole > top) {
+    std::ptrdiff_t parent = parent_of<Arity>(hole);
+    if (!comp(*(first + parent), value))
+      break;
+    *(first + hole) = std::move(*(first + parent));
+    hole = parent;
+  }
+  *(first + hole) = std::forward<T>(value);
+}
+
+/**
+ * @brief 自底向上下沉(大顶堆): 把 value 放入空穴 hole 并恢复 [first, first + len) 的堆序
+ *
+ * @tparam Arity 叉数
+ * @param first 堆首
+ * @param len 堆大小
+ * @param hole 空穴位置, 原有元素已被移走
+ * @param value 待放入的元素
+ * @param comp
+ */
+template <std::size_t Arity, typename RandomIt, typename Compare, typename T>
+void dary_sift_down(RandomIt first, std::ptrdiff_t len, std::ptrdiff_t hole,
+                    T &&value, Compare &comp) {
+  const std::ptrdiff_t top = hole;
+  const std::ptrdiff_t arity = static_cast<std::ptrdiff_t>(Arity);
+  std::ptrdiff_t child = first_child<Arity>(hole);
+  // 子节点满的层: 比较次数为常量, 便于编译器展开
+  for (; child <= len - arity; child = first_child<Arity>(hole)) {
+    if constexpr (std::contiguous_iterator<RandomIt>) {
+      // 下一轮要比较的是某个子节点的子节点, 提前取入第一组和最后一组孙节点
+      const std::ptrdiff_t grand = first_child<Arity>(child);
+      if (grand < len) {
+        __builtin_prefetch(std::to_address(first + grand));
+        __builtin_prefetch(std::to_address(
+            first + std::min(grand + arity * arity - 1, len - 1)));
+      }
+    }
+    const std::ptrdiff_t best = best_child(first, child, Arity, comp);
+    *(first + hole) = std::move(*(first + best));
+    hole = best;
+  }
+  // 最后一层可能只有部分子节点
+  if (child < len) {
+    const std::ptrdiff_t best =
+        best_child(first, child, static_cast<std::size_t>(len - child), comp);
+    *(first + hole) = std::move(*(first + best));
+    hole = best;
+  }
+  dary_sift_up<Arity>(first, hole, top, std::forward<T>(value), comp);
+}
+
+/**
+ * @brief 自顶向下下沉(大顶堆): 每层与 value 比较, 适合 value 预计停在堆顶附近的场景
+ */
+template <std::size_t Arity, typename RandomIt, typename Compare, typename T>
+void dary_sift_down_top(RandomIt first, std::ptrdiff_t len,
+                        std::ptrdiff_t hole, T &&value, Compare &comp) {
+  for (std::ptrdiff_t child = first_child<Arity>(hole); child < len;
+       child = first_child<Arity>(hole)) {
+    const std::ptrdiff_t best = best_child(
+        first, child,
+        std::min(Arity, static_cast<std::size_t>(len - child)), comp);
+    if (!comp(value, *(first + best)))
+      break;
+    *(first + hole) = std::move(*(first + best));
+    hole = best;
+  }
+  *(first + hole) = std::forward<T>(value);
+}
+
+/**
+ * @brief 自底向上建堆, O(n)
+ */
+template <std::size_t Arity, typename RandomIt, typename Compare>
+void dary_make_heap(RandomIt first, std::ptrdiff_t len, Compare &comp) {
+  if (len < 2)
+    return;
+  for (std::ptrdiff_t i = parent_of<Arity>(len - 1); i >= 0; --i) {
+    auto value = std::move(*(first + i));
+    dary_sift_down<Arity>(first, len, i, std::move(value), comp);
+  }
+}
+
+/**
+ * @brief 弹出堆顶: 堆顶移到 first + len - 1, [first, first + len - 1) 仍为堆
+ */
+template <std::size_t Arity, typename RandomIt, typename Compare>
+void dary_pop_heap(RandomIt first, std::ptrdiff_t len, Compare &comp) {
+  auto value = std::move(*(first + len - 1));
+  *(first + len - 1) = std::move(*first);
+  dary_sift_down<Arity>(first, len - 1, 0, std::move(value), comp);
+}
+
+/**
+ * @brief 起始地址满足 (p + 1) 按缓存行对齐的分配器
+ * d叉堆中节点 i 的子节点从下标 d*i+1 开始, 这样每组子节点都从对齐边界开始
+ * (d * sizeof(T) 为64的约数或倍数时一组子节点恰好不跨缓存行)
+ */
+template <typename T> struct HeapAllocator {
+  using value_type = T;
+  static_assert(alignof(T) <= kCacheLine);
+  static constexpr std::size_t kOffset =
+      sizeof(T) < kCacheLine ? kCacheLine - sizeof(T) : 0;
+
+  HeapAllocator() = default;
+  template <typename U> HeapAllocator(const HeapAllocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    auto *raw = static_cast<std::byte *>(::operator new(
+        n * sizeof(T) + kOffset, std::align_val_t{kCacheLine}));
+    return reinterpret_cast<T *>(raw + kOffset);
+  }
+
+  void deallocate(T *p, std::size_t) {
+    ::operator delete(reinterpret_cast<std::byte *>(p) - kOffset,
+                      std::align_val_t{kCacheLine});
+  }
+
+  template <typename U> bool operator==(const HeapAllocator<U> &) const {
+    return true;
+  }
+};
+} // namespace detail
+
+/**
+ * @brief 堆排序(不稳定, 原地), d叉堆 + 自底向上下沉
+ *
+ * @tparam Arity 叉数, 默认4
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param comp
+ */
+template <std::size_t Arity = 4, typename RandomIt,
+          typename Compare = std::less<>>
+  requires(Arity >= 2)
+void heap_sort(RandomIt first, RandomIt last, Compare comp = Compare{}) {
+  const std::ptrdiff_t n = last - first;
+  detail::dary_make_heap<Arity>(first, n, comp);
+  for (std::ptrdiff_t len = n; len > 1; --len)
+    detail::dary_pop_heap<Arity>(first, len, comp);
+}
+
+/**
+ * @brief d叉堆优先队列, 与 std::priority_queue 一样 top() 为按 comp 最大的元素
+ * 子节点按缓存行对齐存放; 额外提供 replace_top, 调度器"取出并放回"只需一次下沉
+ *
+ * @tparam T
+ * @tparam Compare
+ * @tparam Arity 叉数, 默认4
+ */
+template <typename T, typename Compare = std::less<>, std::size_t Arity = 4>
+  requires(Arity >= 2)
+class PriorityQueue {
+public:
+  explicit PriorityQueue(Compare comp = Compare{}) : comp_(std::move(comp)) {}
+
+  /**
+   * @brief 由区间建堆, O(n)
+   */
+  template <std::input_iterator InputIt>
+  PriorityQueue(InputIt first, InputIt last, Compare comp = Compare{})
+      : heap_(first, last), comp_(std::move(comp)) {
+    detail::dary_make_heap<Arity>(heap_.begin(), ssize(), comp_);
+  }
+
+  bool empty() const { return heap_.empty(); }
+  std::size_t size() const { return heap_.size(); }
+  void reserve(std::size_t n) { heap_.reserve(n); }
+  void clear() { heap_.clear(); }
+
+  const T &top() const { return heap_.front(); }
+
+  void push(const T &value) { emplace(value); }
+  void push(T &&value) { emplace(std::move(value)); }
+
+  template <typename... Args> void emplace(Args &&...args) {
+    heap_.emplace_back(std::forward<Args>(args)...);
+    T value = std::move(heap_.back());
+    detail::dary_sift_up<Arity>(heap_.begin(), ssize() - 1, 0,
+                                std::move(value), comp_);
+  }
+
+  void pop() {
+    T value = std::move(heap_.back());
+    heap_.pop_back();
+    if (!heap_.empty())
+      detail::dary_sift_down<Arity>(heap_.begin(), ssize(), 0,
+                                    std::move(value), comp_);
+  }
+
+  /**
+   * @brief 取出堆顶
+   */
+  T pop_top() {
+    T result = std::move(heap_.front());
+    pop();
+    return result;
+  }
+
+  /**
+   * @brief 用 value 替换堆顶, 等价于 pop() 后 push(value), 但只做一次下沉
+   * 调度器放回的元素通常仍靠近堆顶, 因此这里用自顶向下下沉
+   */
+  void replace_top(T value) {
+    detail::dary_sift_down_top<Arity>(heap_.begin(), ssize(), 0,
+                                      std::move(value), comp_);
+  }
+
+private:
+  std::ptrdiff_t ssize() const {
+    return static_cast<std::ptrdiff_t>(heap_.size());
+  }
+
+  std::vector<T, detail::HeapAllocator<T>> heap_;
+  Compare comp_;
+};
+} // namespace ArrayUtils
@@ -0,0 +1,387 @@
+#pragma once
+// 外部排序: 数据量超过内存时, 分块读入 -> 内存排序 -> 写出有序段(run) -> 败者树多路归并
+// 文件内容为定长、可平凡复制的元素的原始字节(本机字节序), 例如 int32/uint64 键
+// 有序段过多时分多趟归并, 保证每一路都有足够大的顺序读缓冲
+#include "utils/introsort.h"
+#include "utils/loser_tree.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ARRAY_UTILS_HAS_MMAP 1
+#endif
+
+namespace ArrayUtils {
+// 外部排序选项
+struct ExternalSortOptions {
+  std::size_t memory_budget = std::size_t(256) << 20; // 内存预算(字节)
+  std::size_t io_block = std::size_t(1) << 20; // 归并时每路最小读缓冲(字节)
+  std::filesystem::path temp_dir =
+      std::filesystem::temp_directory_path(); // 有序段存放目录
+  bool use_mmap = false; // 以 mmap 读取输入与有序段(仅类Unix系统)
+};
+
+namespace detail {
+struct FileCloser {
+  void operator()(std::FILE *f) const { std::fclose(f); }
+};
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+inline FilePtr open_file(const std::filesystem::path &path, const char *mode) {
+  FilePtr f(std::fopen(path.c_str(), mode));
+  if (!f)
+    throw std::system_error(errno, std::generic_category(),
+                            "cannot open " + path.string());
+  std::setvbuf(f.get(), nullptr, _IONBF, 0); // 自行做大块缓冲
+  return f;
+}
+
+/**
+ * @brief 顺序读取定长元素: 普通模式用大块 fread, mmap 模式直接返回映射区视图
+ */
+template <typename T> class BlockReader {
+public:
+  /**
+   * @param path
+   * @param block next() 每次最多返回的元素数, 0 表示只使用 read()
+   * @param use_mmap
+   */
+  BlockReader(const std::filesystem::path &path, std::size_t block,
+              bool use_mmap)
+      : block_(block) {
+#ifdef ARRAY_UTILS_HAS_MMAP
+    if (use_mmap) {
+      map(path);
+      return;
+    }
+#endif
+    file_ = open_file(path, "rb");
+    buffer_.resize(block);
+  }
+
+  ~BlockReader() {
+#ifdef ARRAY_UTILS_HAS_MMAP
+    if (mapped_)
+      ::munmap(const_cast<T *>(mapped_), mapped_count_ * sizeof(T));
+#endif
+  }
+
+  BlockReader(const BlockReader &) = delete;
+  BlockReader &operator=(const BlockReader &) = delete;
+
+  /**
+   * @brief 读取至多 count 个元素到 dst
+   *
+   * @return std::size_t 实际读取数, 0 表示读完
+   */
+  std::size_t read(T *dst, std::size_t count) {
+    if (!file_) {
+      count = std::min(count, mapped_count_ - pos_);
+      std::memcpy(dst, mapped_ + pos_, count * sizeof(T));
+      pos_ += count;
+      return count;
+    }
+    std::size_t got = std::fread(dst, sizeof(T), count, file_.get());
+    if (got < count && std::ferror(file_.get()))
+      throw std::runtime_error("external_sort: read error");
+    return got;
+  }
+
+  /**
+   * @brief 下一段数据, 空视图表示读完; 视图在下次调用前有效
+   */
+  std::span<const T> next() {
+    if (!file_) {
+      std::size_t count = std::min(block_, mapped_count_ - pos_);
+      std::span<const T> view(mapped_ + pos_, count);
+      pos_ += count;
+      return view;
+    }
+    return {buffer_.data(), read(buffer_.data(), block_)};
+  }
+
+private:
+#ifdef ARRAY_UTILS_HAS_MMAP
+  void map(const std::filesystem::path &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(),
+                              "cannot open " + path.string());
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::generic_category(), "fstat");
+    }
+    mapped_count_ = static_cast<std::size_t>(st.st_size) / sizeof(T);
+    if (mapped_count_ > 0) {
+      void *p = ::mmap(nullptr, mapped_count_ * sizeof(T), PROT_READ,
+                       MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "mmap");
+      }
+      ::madvise(p, mapped_count_ * sizeof(T), MADV_SEQUENTIAL);
+      mapped_ = static_cast<const T *>(p);
+    }
+    ::close(fd);
+  }
+#endif
+
+  std::size_t block_;
+  FilePtr file_;
+  std::vector<T> buffer_;
+  const T *mapped_ = nullptr;
+  std::size_t mapped_count_ = 0, pos_ = 0;
+};
+
+/**
+ * @brief 带缓冲的顺序写出
+ */
+template <typename T> class BlockWriter {
+public:
+  BlockWriter(const std::filesystem::path &path, std::size_t block)
+      : file_(open_file(path, "wb")) {
+    buffer_.reserve(std::max<std::size_t>(block, 1));
+  }
+
+  void push(const T &value) {
+    buffer_.push_back(value);
+    if (buffer_.size() == buffer_.capacity())
+      flush();
+  }
+
+  // 直接写出一整段, 不经过缓冲
+  void write(const T *data, std::size_t count) {
+    flush();
+    if (std::fwrite(data, sizeof(T), count, file_.get()) != count)
+      throw std::runtime_error("external_sort: write error");
+  }
+
+  // 写完并关闭, 关闭失败(如磁盘已满)时抛出异常
+  void close() {
+    flush();
+    if (std::fclose(file_.release()) != 0)
+      throw std::runtime_error("external_sort: close error");
+  }
+
+private:
+  void flush() {
+    if (std::fwrite(buffer_.data(), sizeof(T), buffer_.size(), file_.get()) !=
+        buffer_.size())
+      throw std::runtime_error("external_sort: write error");
+    buffer_.clear();
+  }
+
+  FilePtr file_;
+  std::vector<T> buffer_;
+};
+
+/**
+ * @brief 临时目录, 析构时连同其中的有序段一并删除
+ */
+class TempDir {
+public:
+  explicit TempDir(const std::filesystem::path &parent) {
+    std::random_device rd;
+    do {
+      path_ = parent / ("external_sort_" + std::to_string(rd()));
+    } while (!std::filesystem::create_directory(path_));
+  }
+  ~TempDir() {
+    std::error_code ec;
+    std::filesystem::remove_all(path_, ec);
+  }
+  TempDir(const TempDir &) = delete;
+  TempDir &operator=(const TempDir &) = delete;
+
+  std::filesystem::path next_path() {
+    return path_ / (std::to_string(counter_++) + ".run");
+  }
+
+private:
+  std::filesystem::path path_;
+  std::size_t counter_ = 0;
+};
+
+/**
+ * @brief output 同目录下的暂存文件, commit() 时改名覆盖 output, 未提交则析构时删除
+ * output 与 input 相同时, 最后一趟归并不直接截断 output, 写入失败(如磁盘满)也不丢数据
+ */
+class StagedOutput {
+public:
+  explicit StagedOutput(const std::filesystem::path &output)
+      : output_(output) {
+    std::random_device rd;
+    do {
+      path_ = output;
+      path_ += ".tmp" + std::to_string(rd());
+    } while (std::filesystem::exists(path_));
+  }
+  ~StagedOutput() {
+    if (!committed_) {
+      std::error_code ec;
+      std::filesystem::remove(path_, ec);
+    }
+  }
+  StagedOutput(const StagedOutput &) = delete;
+  StagedOutput &operator=(const StagedOutput &) = delete;
+
+  const std::filesystem::path &path() const { return path_; }
+
+  // 同一目录内改名是原子的: output 要么是旧内容, 要么是完整的新内容
+  void commit() {
+    std::filesystem::rename(path_, output_);
+    committed_ = true;
+  }
+
+private:
+  std::filesystem::path output_;
+  std::filesystem::path path_;
+  bool committed_ = false;
+};
+
+/**
+ * @brief 用败者树把若干有序段文件归并到 output
+ *
+ * @param runs
+ * @param output
+ * @param block 每一路与输出的缓冲元素数
+ */
+template <typename T, typename Compare>
+void merge_run_files(const std::vector<std::filesystem::path> &runs,
+                     const std::filesystem::path &output, std::size_t block,
+                     bool use_mmap, Compare &comp) {
+  const std::size_t k = runs.size();
+  std::vector<std::unique_ptr<BlockReader<T>>> readers(k);
+  std::vector<std::span<const T>> views(k);
+  LoserTree<T, std::reference_wrapper<Compare>> tree(k, std::ref(comp));
+  for (std::size_t i = 0; i < k; ++i) {
+    readers[i] = std::make_unique<BlockReader<T>>(runs[i], block, use_mmap);
+    views[i] = readers[i]->next();
+    if (!views[i].empty())
+      tree.set(i, views[i].front());
+  }
+  tree.build();
+
+  BlockWriter<T> writer(output, block);
+  while (!tree.empty()) {
+    const std::size_t s = tree.top();
+    writer.push(tree.top_key());
+    views[s] = views[s].subspan(1);
+    if (views[s].empty())
+      views[s] = readers[s]->next();
+    if (views[s].empty())
+      tree.pop_top();
+    else
+      tree.replace_top(views[s].front());
+  }
+  writer.close();
+}
+} // namespace detail
+
+/**
+ * @brief 外部排序: 对 input 中的定长元素排序并写入 output(可与 input 相同)
+ * 内存占用不超过 options.memory_budget(另有 mmap 模式下由内核管理的页缓存)
+ * 分块内存排序使用内省排序(int/float 走向量化分区); 整体不稳定
+ *
+ * @tparam T 元素类型, 需可平凡复制
+ * @tparam Compare
+ * @param input
+ * @param output
+ * @param comp
+ * @param options
+ */
+template <typename T, typename Compare = std::less<>>
+void external_sort(const std::filesystem::path &input,
+                   const std::filesystem::path &output,
+                   Compare comp = Compare{},
+                   const ExternalSortOptions &options = {}) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "external_sort requires trivially copyable elements");
+  if (std::filesystem::file_size(input) % sizeof(T) != 0)
+    throw std::invalid_argument(
+        "external_sort: file size is not a multiple of the element size");
+  const std::size_t chunk = std::max<std::size_t>(
+      options.memory_budget / sizeof(T), 2);
+
+  detail::TempDir temp(options.temp_dir);
+  std::vector<std::filesystem::path> runs;
+  {
+    // 1. 生成有序段
+    std::vector<T> buffer(chunk);
+    detail::BlockReader<T> reader(input, 0, options.use_mmap);
+    std::size_t got;
+    while ((got = reader.read(buffer.data(), chunk)) > 0) {
+      introsort(buffer.begin(), buffer.begin() + got, comp,
+                PartitionScheme::simd);
+      runs.push_back(temp.next_path());
+      detail::BlockWriter<T> writer(runs.back(), 0);
+      writer.write(buffer.data(), got);
+      writer.close();
+    }
+  }
+  if (runs.empty()) {
+    detail::BlockWriter<T>(output, 0).close();
+    return;
+  }
+  if (runs.size() == 1) {
+    // 整个文件只有一个有序段(元素数可能恰好等于 chunk): 移到 output,
+    // 否则它会随临时目录一起被删除
+    std::error_code ec;
+    std::filesystem::rename(runs.front(), output, ec);
+    if (ec) { // 临时目录与 output 不在同一文件系统: 先复制到 output 旁边
+      detail::StagedOutput staged(output);
+      std::filesystem::copy_file(runs.front(), staged.path());
+      staged.commit();
+    }
+    return;
+  }
+
+  // 2. 多趟归并: 每趟最多 fan_in 路, 每一路(含输出)分得 memory_budget/(路数+1)
+  const std::size_t fan_in = std::max<std::size_t>(
+      options.memory_budget / std::max<std::size_t>(options.io_block, 1), 3) -
+                             1;
+  detail::StagedOutput staged(output);
+  while (runs.size() > 1) {
+    const bool last_pass = runs.size() <= fan_in;
+    std::vector<std::filesystem::path> next;
+    for (std::size_t lo = 0; lo < runs.size(); lo += fan_in) {
+      std::vector<std::filesystem::path> group(
+          runs.begin() + lo,
+          runs.begin() + std::min(lo + fan_in, runs.size()));
+      if (group.size() == 1) {
+        next.push_back(group.front());
+        continue;
+      }
+      const std::size_t block = std::max<std::size_t>(
+          options.memory_budget / ((group.size() + 1) * sizeof(T)), 1);
+      next.push_back(last_pass ? staged.path() : temp.next_path());
+      detail::merge_run_files<T>(group, next.back(), block, options.use_mmap,
+                                 comp);
+      for (const auto &run : group)
+        std::filesystem::remove(run);
+    }
+    runs = std::move(next);
+  }
+  staged.commit();
+}
+} // namespace ArrayUtils
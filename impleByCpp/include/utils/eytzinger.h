@@ -0,0 +1,114 @@
+#pragma once
+// Eytzinger(BFS序)静态查找索引: 有序数组按完全二叉树的层序重新排列, 节点 k 的子节点为 2k, 2k+1
+// 查找时从根一路下降, 每层只做一次比较并据此计算下一个下标, 没有分支预测失败
+// 前几层集中在少数缓存行中常驻缓存; 下标 16k..16k+15(int)是 k 往下第4层的全部后代,
+// 它们位于同一缓存行, 下降时提前取入, 把访存延迟隐藏在后面几层的比较里
+// 适合只读、查询远多于构建的场景; 构建 O(n), 查找 O(log n)
+#include "utils/aligned_allocator.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace SearchUtils {
+/**
+ * @brief Eytzinger 布局的静态有序集合索引, 查询结果为元素在原有序序列中的下标
+ *
+ * @tparam T
+ * @tparam Compare 与构建所用有序序列一致的严格弱序
+ */
+template <typename T, typename Compare = std::less<>> class EytzingerIndex {
+public:
+  EytzingerIndex() = default;
+
+  /**
+   * @brief 由有序区间构建
+   *
+   * @param first
+   * @param last 区间需按 comp 有序, 允许重复元素
+   * @param comp
+   */
+  template <std::random_access_iterator RandomIt>
+  EytzingerIndex(RandomIt first, RandomIt last, Compare comp = Compare{})
+      : n_(static_cast<std::size_t>(last - first)), comp_(std::move(comp)) {
+    tree_.resize(n_ + 1); // 下标0不用, 根为1
+    for (std::size_t k = 1; k <= n_; ++k)
+      tree_[k] = first[rank_of(k)];
+  }
+
+  explicit EytzingerIndex(const std::vector<T> &sorted,
+                          Compare comp = Compare{})
+      : EytzingerIndex(sorted.begin(), sorted.end(), std::move(comp)) {}
+
+  std::size_t size() const { return n_; }
+  bool empty() const { return n_ == 0; }
+
+  /**
+   * @brief 第一个不小于 x 的元素的下标, 不存在时返回 size()
+   */
+  std::size_t lower_bound(const T &x) const {
+    return rank_of(descend([&](const T &v) { return comp_(v, x); }));
+  }
+
+  /**
+   * @brief 第一个大于 x 的元素的下标, 不存在时返回 size()
+   */
+  std::size_t upper_bound(const T &x) const {
+    return rank_of(descend([&](const T &v) { return !comp_(x, v); }));
+  }
+
+  bool contains(const T &x) const {
+    const std::size_t k = descend([&](const T &v) { return comp_(v, x); });
+    return k != 0 && !comp_(x, tree_[k]);
+  }
+
+private:
+  // 一个缓存行容纳的元素数, 即从 k 往下 log2(kStride) 层的全部后代
+  static constexpr std::size_t kStride =
+      std::bit_floor(std::max<std::size_t>(detail::kCacheLine / sizeof(T), 1));
+
+  /**
+   * @brief 从根下降: go_right(v) 为真时进入右子树
+   * 返回最后一次向左转的节点, 即第一个 go_right 为假的元素; 没有时返回0
+   */
+  template <typename GoRight> std::size_t descend(GoRight go_right) const {
+    const auto base = reinterpret_cast<std::uintptr_t>(tree_.data());
+    std::size_t k = 1;
+    while (k <= n_) {
+      // 只是预取提示, 越界地址不会被访问, 因此按整数计算地址
+      __builtin_prefetch(
+          reinterpret_cast<const void *>(base + k * kStride * sizeof(T)));
+      k = 2 * k + static_cast<std::size_t>(go_right(tree_[k]));
+    }
+    // 去掉末尾连续的右转以及最后一次左转
+    return k >> (std::countr_one(k) + 1);
+  }
+
+  /**
+   * @brief 节点 k 在有序序列中的下标(中序序号), k 为0时返回 size()
+   * 先按高为 H 的满二叉树计算中序序号, 再减去排在它前面的缺失叶子数
+   * 满二叉树中最后一层第 j 个叶子的序号为 2j, 缺失的叶子都在最后一层末尾
+   */
+  std::size_t rank_of(std::size_t k) const {
+    if (k == 0)
+      return n_;
+    const auto height = static_cast<std::size_t>(std::bit_width(n_));
+    const auto depth = static_cast<std::size_t>(std::bit_width(k)) - 1;
+    std::size_t rank =
+        ((2 * (k - (std::size_t(1) << depth)) + 1) << (height - 1 - depth)) - 1;
+    // 最后一层实际存在的叶子数
+    const std::size_t leaves = n_ - ((std::size_t(1) << (height - 1)) - 1);
+    if (rank > 2 * leaves)
+      rank -= (rank - 2 * leaves + 1) / 2;
+    return rank;
+  }
+
+  std::vector<T, detail::AlignedAllocator<T>> tree_;
+  std::size_t n_ = 0;
+  Compare comp_;
+};
+} // namespace SearchUtils
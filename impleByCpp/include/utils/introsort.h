@@ -0,0 +1,264 @@
+#pragma once
+// 内省排序(introsort): 快速排序 + 堆排序兜底 + 小区间插入排序/排序网络
+// 接受任意随机访问迭代器区间与比较器, 最坏时间复杂度 O(nlogn), 栈深度 O(logn)
+#include "utils/block_partition.h"
+#include "utils/simd_sort.h"
+#include "utils/sort_stats.h"
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace ArrayUtils {
+// 快速排序/选择使用的分区策略
+enum class PartitionScheme {
+  hoare, // 经典Hoare分区, 适用于任意类型
+  simd,  // 向量化分区(int/float 且 std::less), 其余情况退化为hoare
+  block, // 无分支块分区(BlockQuicksort), 适用于任意类型, 无需SIMD
+};
+
+namespace detail {
+inline constexpr std::ptrdiff_t kInsertionSortThreshold = 16; // 小区间阈值
+inline constexpr std::ptrdiff_t kNintherThreshold = 128;      // ninther阈值
+
+/**
+ * @brief 插入排序(迭代器版本), 用于小区间
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param comp
+ */
+template <typename RandomIt, typename Compare>
+void insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+  if (first == last)
+    return;
+  for (RandomIt cur = first + 1; cur != last; ++cur) {
+    if (!comp(*cur, *(cur - 1)))
+      continue;
+    auto key = std::move(*cur);
+    RandomIt hole = cur;
+    do {
+      *hole = std::move(*(hole - 1));
+      --hole;
+    } while (hole != first && comp(key, *(hole - 1)));
+    *hole = std::move(key);
+  }
+}
+
+/**
+ * @brief 迭代式下沉(大顶堆), 以"空穴"方式移动元素减少交换
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first 堆首
+ * @param len 堆大小
+ * @param hole 下沉起点
+ * @param comp
+ */
+template <typename RandomIt, typename Compare>
+void sift_down(RandomIt first, std::ptrdiff_t len, std::ptrdiff_t hole,
+               Compare &comp) {
+  auto value = std::move(*(first + hole));
+  for (std::ptrdiff_t child = 2 * hole + 1; child < len;
+       child = 2 * hole + 1) {
+    if (child + 1 < len && comp(*(first + child), *(first + child + 1)))
+      ++child;
+    if (!comp(value, *(first + child)))
+      break;
+    *(first + hole) = std::move(*(first + child));
+    hole = child;
+  }
+  *(first + hole) = std::move(value);
+}
+
+/**
+ * @brief 堆排序(迭代器版本), 内省排序递归过深时的兜底
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param comp
+ */
+template <typename RandomIt, typename Compare>
+void heap_sort(RandomIt first, RandomIt last, Compare &comp) {
+  std::ptrdiff_t n = last - first;
+  for (std::ptrdiff_t i = n / 2 - 1; i >= 0; --i)
+    sift_down(first, n, i, comp);
+  for (std::ptrdiff_t i = n - 1; i > 0; --i) {
+    std::iter_swap(first, first + i);
+    sift_down(first, i, 0, comp);
+  }
+}
+
+/**
+ * @brief 将三个位置排为 *a <= *b <= *c
+ */
+template <typename RandomIt, typename Compare>
+void sort3(RandomIt a, RandomIt b, RandomIt c, Compare &comp) {
+  if (comp(*b, *a))
+    std::iter_swap(a, b);
+  if (comp(*c, *b)) {
+    std::iter_swap(b, c);
+    if (comp(*b, *a))
+      std::iter_swap(a, b);
+  }
+}
+
+/**
+ * @brief 选取枢轴并放到区间首位: 小区间三数取中, 大区间使用ninther(九数取中)
+ */
+template <typename RandomIt, typename Compare>
+void choose_pivot(RandomIt first, RandomIt last, Compare &comp) {
+  std::ptrdiff_t n = last - first;
+  RandomIt mid = first + n / 2;
+  if (n > kNintherThreshold) {
+    sort3(first, mid, last - 1, comp);
+    sort3(first + 1, mid - 1, last - 2, comp);
+    sort3(first + 2, mid + 1, last - 3, comp);
+    sort3(mid - 1, mid, mid + 1, comp);
+    std::iter_swap(first, mid);
+  } else {
+    sort3(mid, first, last - 1, comp);
+  }
+}
+
+/**
+ * @brief Hoare式分区, 枢轴位于 *first; 相等元素两侧均停下交换, 重复值多时仍能均分
+ *
+ * @return RandomIt 枢轴最终位置p: [first, p) <= *p <= (p, last)
+ */
+template <typename RandomIt, typename Compare>
+RandomIt partition_pivot(RandomIt first, RandomIt last, Compare &comp) {
+  auto pivot = std::move(*first);
+  RandomIt i = first + 1, j = last - 1;
+  while (true) {
+    while (i <= j && comp(*i, pivot))
+      ++i;
+    while (i <= j && comp(pivot, *j))
+      --j;
+    if (i >= j)
+      break;
+    std::iter_swap(i, j);
+    ++i;
+    --j;
+  }
+  if (j != first)
+    *first = std::move(*j);
+  *j = std::move(pivot);
+  return j;
+}
+
+/**
+ * @brief 以 *first 为枢轴分区
+ *
+ * @return std::pair<RandomIt, RandomIt> [lo, hi) 内元素均等于枢轴且已在最终位置,
+ * [first, lo) 不大于枢轴, [hi, last) 不小于枢轴
+ */
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, RandomIt> partition_range(RandomIt first, RandomIt last,
+                                              Compare &comp,
+                                              PartitionScheme scheme) {
+  if constexpr (kHasSmallSort<RandomIt, Compare>) {
+    if (scheme == PartitionScheme::simd) {
+      auto *base = std::to_address(first);
+      const auto pivot = *base;
+      const auto n = static_cast<std::size_t>(last - first) - 1;
+      auto k =
+          static_cast<std::ptrdiff_t>(simd_partition(base + 1, n, pivot));
+      if (k == 0) {
+        // 枢轴即最小值: 把等于枢轴的元素集中到前部, 它们已就位, 避免重复值退化
+        auto equal = static_cast<std::ptrdiff_t>(
+            simd_partition(base + 1, n, pivot, true));
+        return {first, first + 1 + equal};
+      }
+      std::iter_swap(first, first + k);
+      return {first + k, first + k + 1};
+    }
+  }
+  if (scheme == PartitionScheme::block) {
+    // 枢轴留在 *first 不参与分区, 谓词直接引用它
+    auto &pivot = *first;
+    RandomIt k = block_partition(
+        first + 1, last, [&](const auto &x) { return comp(x, pivot); });
+    if (k == first + 1) {
+      // 同 simd: 枢轴即最小值时收拢等于枢轴的元素
+      RandomIt equal = block_partition(
+          first + 1, last, [&](const auto &x) { return !comp(pivot, x); });
+      return {first, equal};
+    }
+    std::iter_swap(first, k - 1);
+    return {k - 1, k};
+  }
+  RandomIt p = partition_pivot(first, last, comp);
+  return {p, p + 1};
+}
+
+/**
+ * @brief 小区间排序: int/float 升序走排序网络, 其余类型走插入排序
+ */
+template <typename RandomIt, typename Compare>
+void small_range_sort(RandomIt first, RandomIt last, Compare &comp) {
+  if constexpr (kHasSmallSort<RandomIt, Compare>)
+    ArrayUtils::small_sort(std::to_address(first),
+                           static_cast<std::size_t>(last - first));
+  else
+    insertion_sort(first, last, comp);
+}
+
+template <typename RandomIt, typename Compare>
+inline constexpr std::ptrdiff_t kSmallRangeThreshold =
+    kHasSmallSort<RandomIt, Compare>
+        ? static_cast<std::ptrdiff_t>(kSmallSortMax)
+        : kInsertionSortThreshold;
+
+template <typename RandomIt, typename Compare>
+void introsort_loop(RandomIt first, RandomIt last, int depth_limit,
+                    Compare &comp, PartitionScheme scheme,
+                    std::size_t depth = 1) {
+  note_depth(comp, depth);
+  while (last - first > kSmallRangeThreshold<RandomIt, Compare>) {
+    if (depth_limit == 0) {
+      detail::heap_sort(first, last, comp);
+      return;
+    }
+    --depth_limit;
+    choose_pivot(first, last, comp);
+    auto [lo, hi] = partition_range(first, last, comp, scheme);
+    // 只对较小的一侧递归, 较大的一侧继续循环, 保证栈深度 O(logn)
+    if (lo - first < last - hi) {
+      introsort_loop(first, lo, depth_limit, comp, scheme, depth + 1);
+      first = hi;
+    } else {
+      introsort_loop(hi, last, depth_limit, comp, scheme, depth + 1);
+      last = lo;
+    }
+  }
+  small_range_sort(first, last, comp);
+}
+} // namespace detail
+
+/**
+ * @brief 内省排序(不稳定)
+ *
+ * @tparam RandomIt 随机访问迭代器
+ * @tparam Compare 严格弱序比较器
+ * @param first
+ * @param last
+ * @param comp
+ * @param scheme 分区策略
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void introsort(RandomIt first, RandomIt last, Compare comp = Compare{},
+               PartitionScheme scheme = PartitionScheme::hoare) {
+  auto n = static_cast<std::size_t>(last - first);
+  if (n < 2)
+    return;
+  int depth_limit = 2 * static_cast<int>(std::bit_width(n));
+  detail::introsort_loop(first, last, depth_limit, comp, scheme);
+}
+} // namespace ArrayUtils
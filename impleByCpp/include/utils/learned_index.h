@@ -0,0 +1,216 @@
+#pragma once
+// 学习型索引(PGM风格, 整数键): 插值查找假设全局线性分布, 这里把"键 -> 下标"拟合成分段线性函数
+// 每段保证预测误差不超过 Epsilon, 查找时先由模型给出位置, 再在宽度 2*Epsilon 的窗口里二分(最后一公里)
+// 拟合用收缩锥(shrinking cone)贪心算法: 线段过段首点, 每加入一点就收窄可行斜率区间, 区间为空时开新段, O(n)
+// 各段首键再递归拟合一层(误差 EpsilonRecursive), 直到只剩一段作为根; 查找时逐层预测并在小窗口中确定段
+// 键接近均匀(如时间戳)时只需极少的段, 索引大小通常不到数据的千分之一, 最后一公里只访问几个缓存行
+// 不拷贝数据: 调用方需保证有序数组在索引生命周期内有效且不被修改
+#include "utils/aligned_allocator.h"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <vector>
+
+namespace SearchUtils {
+/**
+ * @brief 分段线性学习型索引, 查询结果为元素在有序数组中的下标
+ *
+ * @tparam Key 整数键
+ * @tparam Epsilon 数据层每段的最大预测误差, 决定最后一公里的窗口宽度
+ * @tparam EpsilonRecursive 上层(段首键)的最大预测误差
+ */
+template <std::integral Key, std::size_t Epsilon = 32,
+          std::size_t EpsilonRecursive = 4>
+class PgmIndex {
+  static_assert(Epsilon >= 1 && EpsilonRecursive >= 1,
+                "误差至少为1, 否则上层无法收缩");
+
+public:
+  PgmIndex() = default;
+
+  /**
+   * @brief 由升序数组构建, 允许重复元素
+   *
+   * @param sorted
+   */
+  explicit PgmIndex(std::span<const Key> sorted) : data_(sorted) {
+    levels_.push_back(fit(data_, Epsilon));
+    while (levels_.back().keys.size() > 1)
+      levels_.push_back(fit(levels_.back().keys, EpsilonRecursive));
+  }
+
+  // 索引不持有数据, 临时容器(如函数返回的 vector)构造后会立即悬空
+  template <std::ranges::range R>
+    requires(!std::ranges::borrowed_range<R>)
+  PgmIndex(R &&) = delete;
+
+  std::size_t size() const { return data_.size(); }
+  bool empty() const { return data_.empty(); }
+
+  /**
+   * @brief 构建索引所用的有序数组
+   */
+  std::span<const Key> data() const { return data_; }
+
+  /**
+   * @brief 数据层的段数
+   */
+  std::size_t segments() const {
+    return levels_.empty() ? 0 : levels_.front().keys.size();
+  }
+
+  /**
+   * @brief 索引本身(不含数据)占用的字节数
+   */
+  std::size_t size_in_bytes() const {
+    std::size_t bytes = 0;
+    for (const auto &level : levels_)
+      bytes += level.keys.size() * (sizeof(Key) + sizeof(Model));
+    return bytes;
+  }
+
+  /**
+   * @brief 第一个不小于 x 的元素的下标, 不存在时返回 size()
+   */
+  std::size_t lower_bound(Key x) const {
+    if (data_.empty())
+      return 0;
+    std::size_t s = 0; // 当前层中 x 所在的段
+    for (std::size_t l = levels_.size() - 1; l > 0; --l) {
+      const std::vector<Key> &keys = levels_[l - 1].keys;
+      const std::size_t r = search(levels_[l], s, keys, EpsilonRecursive, x);
+      // 最后一个段首键不大于 x 的段; x 小于全部键时为第0段
+      s = r < keys.size() && keys[r] == x ? r
+                                          : std::max<std::size_t>(r, 1) - 1;
+    }
+    return search(levels_.front(), s, data_, Epsilon, x);
+  }
+
+  /**
+   * @brief 第一个大于 x 的元素的下标, 不存在时返回 size()
+   */
+  std::size_t upper_bound(Key x) const {
+    return x == std::numeric_limits<Key>::max() ? size() : lower_bound(x + 1);
+  }
+
+  bool contains(Key x) const {
+    const std::size_t i = lower_bound(x);
+    return i < data_.size() && data_[i] == x;
+  }
+
+private:
+  // 段 s 的模型: 过点 (keys[s], rank), 斜率为 slope
+  struct Model {
+    double slope;
+    std::size_t rank;
+  };
+
+  // 一层: 各段的首键与模型, 首键严格递增
+  struct Level {
+    std::vector<Key> keys;
+    std::vector<Model> models;
+  };
+
+  /**
+   * @brief 拟合 x -> lower_bound(x) 的分段线性函数, 使任意整数 x 的预测误差不超过 eps
+   * 对每个不同的键 k 取点 (k, k 第一次出现的下标); 若 k + 1 不是下一个键, 再取点
+   * (k + 1, 下一个键第一次出现的下标), 这样相邻两点之间的整数查询答案都等于右侧点的值,
+   * 而线段单调不减, 夹在两点预测值之间的预测自然也在误差范围内
+   */
+  static Level fit(std::span<const Key> keys, std::size_t eps) {
+    Level level;
+    const auto e = static_cast<double>(eps);
+    double x0 = 0, slope_lo = 0, slope_hi = 0;
+    std::size_t y0 = 0;
+    auto add = [&](Key x, std::size_t y) {
+      if (!level.keys.empty()) {
+        const double dx = static_cast<double>(x) - x0;
+        const double dy = static_cast<double>(y - y0);
+        const double lo = std::max(slope_lo, (dy - e) / dx);
+        const double hi = std::min(slope_hi, (dy + e) / dx);
+        if (lo <= hi) {
+          slope_lo = lo;
+          slope_hi = hi;
+          return;
+        }
+        level.models.back().slope = (slope_lo + slope_hi) / 2;
+      }
+      level.keys.push_back(x);
+      level.models.push_back({0, y});
+      x0 = static_cast<double>(x);
+      y0 = y;
+      slope_lo = 0;
+      slope_hi = std::numeric_limits<double>::infinity();
+    };
+
+    for (std::size_t i = 0; i < keys.size();) {
+      const Key k = keys[i];
+      add(k, i);
+      while (i < keys.size() && keys[i] == k)
+        ++i;
+      if (k != std::numeric_limits<Key>::max() &&
+          (i == keys.size() || keys[i] != k + 1))
+        add(k + 1, i);
+    }
+    // 只有一个点的段斜率保持为0
+    if (!level.keys.empty() && std::isfinite(slope_hi))
+      level.models.back().slope = (slope_lo + slope_hi) / 2;
+    return level;
+  }
+
+  /**
+   * @brief 用 level 的第 s 段预测 x 在 keys 中的 lower_bound, 再在预测窗口内二分
+   * 答案必在 [本段起点, 下一段起点] 内; 浮点舍入使窗口偏离时向两侧补查, 保证结果正确
+   */
+  static std::size_t search(const Level &level, std::size_t s,
+                            std::span<const Key> keys, std::size_t eps, Key x) {
+    const Model &model = level.models[s];
+    const std::size_t first = model.rank;
+    const std::size_t last =
+        s + 1 < level.models.size() ? level.models[s + 1].rank : keys.size();
+    const double dx =
+        static_cast<double>(x) - static_cast<double>(level.keys[s]);
+    // 先在浮点数上截断到本段范围, 再取整; 窗口两端用整数计算
+    const double offset = std::clamp(model.slope * dx, 0.0,
+                                     static_cast<double>(last - first));
+    const std::size_t pos = first + static_cast<std::size_t>(offset);
+    const std::size_t lo = pos - std::min(pos - first, eps);
+    const std::size_t hi = std::min(last, pos + eps + 1);
+
+    const Key *base = keys.data();
+    // 窗口只有几个缓存行, 一次全部预取, 让二分各步的访存并行而不是逐个等待
+    for (std::size_t k = lo; k < hi; k += detail::kCacheLine / sizeof(Key))
+      __builtin_prefetch(base + k);
+    __builtin_prefetch(base + hi - 1);
+    std::size_t i = bounded_lower_bound(base + lo, hi - lo, x) + lo;
+    if (i == lo && lo > first && base[lo - 1] >= x)
+      i = bounded_lower_bound(base + first, lo - first, x) + first;
+    else if (i == hi && hi < last && base[hi] < x)
+      i = bounded_lower_bound(base + hi, last - hi, x) + hi;
+    return i;
+  }
+
+  /**
+   * @brief 窗口内的无分支二分: 窗口很短, 步数固定, 用乘法代替条件跳转
+   */
+  static std::size_t bounded_lower_bound(const Key *data, std::size_t n,
+                                         Key x) {
+    if (n == 0)
+      return 0;
+    const Key *base = data;
+    while (n > 1) {
+      const std::size_t half = n / 2;
+      base += half * static_cast<std::size_t>(base[half - 1] < x);
+      n -= half;
+    }
+    return static_cast<std::size_t>(base - data) + (*base < x);
+  }
+
+  std::span<const Key> data_;
+  std::vector<Level> levels_; // levels_[0] 为数据层, 最后一层只有一段
+};
+} // namespace SearchUtils
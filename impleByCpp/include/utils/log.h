@@ -0,0 +1,46 @@
+#pragma once
+// 诊断日志策略: 库内的状态提示(非法输入、增删顶点、析构等)统一经 log_utils::log 输出
+// 默认编译期关闭, 调用点不生成任何代码, 算法本身不再有 I/O 副作用;
+// 以 DSA_ENABLE_LOG 编译(CMake 选项同名)时开启, 消息交给可替换的 sink, 默认写到 std::clog
+// 遍历结果不属于日志: 遍历类接口通过访问器回调或返回值交出结果, 打印由调用方决定
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace log_utils {
+#ifdef DSA_ENABLE_LOG
+inline constexpr bool kEnabled = true;
+#else
+inline constexpr bool kEnabled = false;
+#endif
+
+using Sink = void (*)(const std::string &message);
+
+inline void clog_sink(const std::string &message) {
+  std::clog << message << '\n';
+}
+
+namespace detail {
+inline Sink sink = clog_sink;
+} // namespace detail
+
+/**
+ * @brief 替换日志输出目标
+ *
+ * @param sink 新的输出函数
+ * @return Sink 原来的输出函数, 便于恢复
+ */
+inline Sink set_sink(Sink sink) { return std::exchange(detail::sink, sink); }
+
+/**
+ * @brief 输出一条日志, 各参数依次以 operator<< 拼接; 未开启时为空函数
+ */
+template <typename... Args> void log([[maybe_unused]] const Args &...args) {
+  if constexpr (kEnabled) {
+    std::ostringstream os;
+    (os << ... << args);
+    detail::sink(os.str());
+  }
+}
+} // namespace log_utils
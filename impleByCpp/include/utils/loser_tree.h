@@ -0,0 +1,121 @@
+#pragma once
+// 败者树(loser tree): k 路归并时每取出一个元素只需沿叶到根比较 log2(k) 次,
+// 比二叉堆的下沉(每层两次比较)更少; 内部结点直接保存败者的键, 重放时不必间接访问各路数据
+// 键相等时编号小的一路胜出, 因此按输入顺序排列各路即可得到稳定归并
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+template <typename T, typename Compare = std::less<>> class LoserTree {
+public:
+  /**
+   * @brief 构造 k 路败者树, 各路初始均视为已耗尽
+   *
+   * @param k 路数
+   * @param comp
+   */
+  explicit LoserTree(std::size_t k, Compare comp = Compare{})
+      : k_(k), nodes_(k == 0 ? 1 : k), leaf_init_(k), comp_(std::move(comp)) {
+  }
+
+  // 路数
+  std::size_t size() const { return k_; }
+
+  /**
+   * @brief 设置第 i 路的首个键(build 之前调用), 未设置的路视为空
+   */
+  void set(std::size_t i, const T &key) {
+    leaf_init_[i].key = key;
+    leaf_init_[i].done = false;
+  }
+
+  /**
+   * @brief 由各路首键建树, O(k)
+   */
+  void build() {
+    for (std::size_t i = 0; i < k_; ++i)
+      leaf_init_[i].source = static_cast<std::uint32_t>(i);
+    if (k_ == 0) {
+      nodes_[0].done = true;
+      return;
+    }
+    // winners[n]: 以 n 为根的子树的胜者; 叶子 i 位于 k + i
+    std::vector<Node> winners(2 * k_);
+    for (std::size_t i = 0; i < k_; ++i)
+      winners[k_ + i] = leaf_init_[i];
+    for (std::size_t n = k_ - 1; n >= 1; --n) {
+      Node &l = winners[2 * n], &r = winners[2 * n + 1];
+      if (beats(l, r)) {
+        nodes_[n] = std::move(r);
+        winners[n] = std::move(l);
+      } else {
+        nodes_[n] = std::move(l);
+        winners[n] = std::move(r);
+      }
+    }
+    nodes_[0] = std::move(winners[1]);
+    leaf_init_ = {};
+  }
+
+  // 所有路是否都已耗尽
+  bool empty() const { return nodes_[0].done; }
+
+  // 当前最小键所在的路
+  std::size_t top() const { return nodes_[0].source; }
+
+  // 当前最小键
+  const T &top_key() const { return nodes_[0].key; }
+
+  /**
+   * @brief 胜者所在路前进一个元素, key 为该路的下一个键
+   */
+  void replace_top(const T &key) {
+    nodes_[0].key = key;
+    replay();
+  }
+
+  /**
+   * @brief 胜者所在路已耗尽
+   */
+  void pop_top() {
+    nodes_[0].done = true;
+    replay();
+  }
+
+private:
+  struct Node {
+    T key{};
+    std::uint32_t source = 0;
+    bool done = true; // 该路已耗尽, 视为比任何键都大
+  };
+
+  // a 是否应排在 b 之前
+  bool beats(const Node &a, const Node &b) const {
+    if (a.done || b.done)
+      return !a.done || (b.done && a.source < b.source);
+    if (comp_(a.key, b.key))
+      return true;
+    if (comp_(b.key, a.key))
+      return false;
+    return a.source < b.source;
+  }
+
+  // 新胜者从其叶子的父结点一路比较到根, 沿途与败者交换
+  void replay() {
+    Node winner = std::move(nodes_[0]);
+    for (std::size_t n = (k_ + winner.source) / 2; n >= 1; n /= 2) {
+      if (beats(nodes_[n], winner))
+        std::swap(nodes_[n], winner);
+    }
+    nodes_[0] = std::move(winner);
+  }
+
+  std::size_t k_;
+  std::vector<Node> nodes_; // nodes_[0] 为胜者, nodes_[1..k) 为内部结点保存的败者
+  std::vector<Node> leaf_init_; // build 之前暂存各路首键
+  Compare comp_;
+};
+} // namespace ArrayUtils
@@ -0,0 +1,292 @@
+#pragma once
+// 稳定归并排序: 整个排序只使用一块预分配的辅助缓冲区, 并提供并行版本
+// 并行版本: 叶子块并行排序 + 每层按 co-rank 切分输出, 使各层归并都能占满线程
+// 限额版本: 使用调用方提供的(可以很小的)缓冲区, 不足时退化为旋转式原地归并, 不做任何分配
+#include "utils/adaptive_sort.h"
+#include "utils/introsort.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::ptrdiff_t kMergeRunLength = 32; // 插入排序生成的初始有序段
+
+/**
+ * @brief 稳定合并 [a, a_end) 与 [b, b_end) 到 out, 相等时优先取左侧
+ */
+template <typename InIt, typename OutIt, typename Compare>
+OutIt merge_move(InIt a, InIt a_end, InIt b, InIt b_end, OutIt out,
+                 Compare &comp) {
+  while (a != a_end && b != b_end) {
+    if (comp(*b, *a))
+      *out++ = std::move(*b++);
+    else
+      *out++ = std::move(*a++);
+  }
+  out = std::move(a, a_end, out);
+  return std::move(b, b_end, out);
+}
+
+/**
+ * @brief co-rank: 求合并结果前k个元素中来自 a 的个数(与 merge_move 的稳定规则一致)
+ *
+ * @return std::ptrdiff_t i, 使合并结果前k个元素恰为 a[0, i) 与 b[0, k - i)
+ */
+template <typename It, typename Compare>
+std::ptrdiff_t co_rank(std::ptrdiff_t k, It a, std::ptrdiff_t n, It b,
+                       std::ptrdiff_t m, Compare &comp) {
+  std::ptrdiff_t lo = std::max<std::ptrdiff_t>(0, k - m);
+  std::ptrdiff_t hi = std::min(k, n);
+  while (lo < hi) {
+    std::ptrdiff_t i = lo + (hi - lo) / 2;
+    std::ptrdiff_t j = k - i;
+    // a[i] 应排在 b[j - 1] 之前, 说明 i 取小了
+    if (j > 0 && !comp(*(b + (j - 1)), *(a + i)))
+      lo = i + 1;
+    else
+      hi = i;
+  }
+  return lo;
+}
+
+/**
+ * @brief 自底向上的稳定归并排序, buf 至少与区间等长
+ * 先用小区间排序生成初始有序段, 再在原区间与 buf 之间来回归并
+ */
+template <typename RandomIt, typename BufIt, typename Compare>
+void merge_sort_buffered(RandomIt first, RandomIt last, BufIt buf,
+                         Compare &comp) {
+  constexpr std::ptrdiff_t run = kHasSmallSort<RandomIt, Compare>
+                                     ? static_cast<std::ptrdiff_t>(
+                                           kSmallSortMax)
+                                     : kMergeRunLength;
+  std::ptrdiff_t n = last - first;
+  for (std::ptrdiff_t lo = 0; lo < n; lo += run)
+    small_range_sort(first + lo, first + std::min(lo + run, n), comp);
+  if (n <= run)
+    return;
+
+  bool in_buf = false; // 当前有序数据是否位于 buf
+  std::size_t passes = 1;
+  for (std::ptrdiff_t width = run; width < n; width *= 2, ++passes) {
+    for (std::ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+      std::ptrdiff_t mid = std::min(lo + width, n);
+      std::ptrdiff_t hi = std::min(lo + 2 * width, n);
+      if (in_buf)
+        merge_move(buf + lo, buf + mid, buf + mid, buf + hi, first + lo,
+                   comp);
+      else
+        merge_move(first + lo, first + mid, first + mid, first + hi,
+                   buf + lo, comp);
+    }
+    in_buf = !in_buf;
+  }
+  note_depth(comp, passes);
+  if (in_buf)
+    std::move(buf, buf + n, first);
+}
+
+/**
+ * @brief 缓冲区受限的稳定合并 [first, mid) 与 [mid, last)
+ * 较短一段能放进 buf 时做 galloping 归并; 否则把较长一段对半切开,
+ * 在另一段中二分找到对应切点, 旋转后分成两个更小的子问题
+ */
+template <typename RandomIt, typename BufIt, typename Compare>
+void merge_adaptive(RandomIt first, RandomIt mid, RandomIt last, BufIt buf,
+                    std::ptrdiff_t buf_size, Compare &comp) {
+  while (true) {
+    const std::ptrdiff_t n1 = mid - first, n2 = last - mid;
+    if (n1 == 0 || n2 == 0)
+      return;
+    if (n1 + n2 == 2) {
+      if (comp(*mid, *first))
+        std::iter_swap(first, mid);
+      return;
+    }
+    if (std::min(n1, n2) <= buf_size) {
+      std::ptrdiff_t min_gallop = kMinGallop;
+      merge_runs(first, mid, last, buf, min_gallop, comp);
+      return;
+    }
+    RandomIt cut1, cut2;
+    if (n1 > n2) {
+      cut1 = first + n1 / 2;
+      cut2 = std::lower_bound(mid, last, *cut1, comp);
+    } else {
+      cut2 = mid + n2 / 2;
+      cut1 = std::upper_bound(first, mid, *cut2, comp);
+    }
+    RandomIt new_mid = std::rotate(cut1, mid, cut2);
+    // 较小的子问题递归, 较大的继续循环
+    if ((cut1 - first) + (new_mid - cut1) < (cut2 - new_mid) + (last - cut2)) {
+      merge_adaptive(first, cut1, new_mid, buf, buf_size, comp);
+      first = new_mid;
+      mid = cut2;
+    } else {
+      merge_adaptive(new_mid, cut2, last, buf, buf_size, comp);
+      mid = cut1;
+      last = new_mid;
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief 使用调用方缓冲区的稳定归并排序, 排序过程不分配内存
+ * buf_size >= (n + 1) / 2 时为 O(nlogn); 缓冲区越小旋转越多, buf_size 为0时
+ * 完全原地, O(nlog²n)
+ *
+ * @tparam RandomIt
+ * @tparam BufIt 缓冲区迭代器, 指向至少 buf_size 个已构造的元素
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param buf
+ * @param buf_size
+ * @param comp
+ */
+template <typename RandomIt, typename BufIt, typename Compare = std::less<>>
+void stable_merge_sort(RandomIt first, RandomIt last, BufIt buf,
+                       std::ptrdiff_t buf_size, Compare comp = Compare{}) {
+  constexpr std::ptrdiff_t run = detail::kHasSmallSort<RandomIt, Compare>
+                                     ? static_cast<std::ptrdiff_t>(
+                                           kSmallSortMax)
+                                     : detail::kMergeRunLength;
+  const std::ptrdiff_t n = last - first;
+  for (std::ptrdiff_t lo = 0; lo < n; lo += run)
+    detail::small_range_sort(first + lo, first + std::min(lo + run, n), comp);
+  for (std::ptrdiff_t width = run; width < n; width *= 2) {
+    for (std::ptrdiff_t lo = 0; lo + width < n; lo += 2 * width)
+      detail::merge_adaptive(first + lo, first + lo + width,
+                             first + std::min(lo + 2 * width, n), buf,
+                             buf_size, comp);
+  }
+}
+
+/**
+ * @brief 内存受限的稳定归并排序: 最多分配 max_buffer 个元素的缓冲区(仅一次)
+ * 峰值额外内存为 min(max_buffer, (n + 1) / 2) 个元素; 值类型需可默认构造
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param max_buffer 缓冲区元素数上限, 0 表示完全原地
+ * @param comp
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void stable_merge_sort(RandomIt first, RandomIt last, std::size_t max_buffer,
+                       Compare comp = Compare{}) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  const std::size_t n = static_cast<std::size_t>(last - first);
+  std::vector<T> buffer(std::min(max_buffer, (n + 1) / 2));
+  if (!buffer.empty())
+    detail::note_allocation(comp, buffer.size() * sizeof(T));
+  stable_merge_sort(first, last, buffer.begin(),
+                    static_cast<std::ptrdiff_t>(buffer.size()), comp);
+}
+
+/**
+ * @brief 并行稳定归并排序
+ * 辅助缓冲区只在入口分配一次; 值类型需可默认构造
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param comp
+ * @param options 并发度与任务粒度
+ * @param pool 执行所用线程池
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_merge_sort(RandomIt first, RandomIt last,
+                         Compare comp = Compare{},
+                         const ParallelSortOptions &options = {},
+                         ThreadPool &pool = ThreadPool::instance()) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  const std::ptrdiff_t n = last - first;
+  if (n < 2)
+    return;
+
+  std::size_t threads = options.threads == 0
+                            ? pool.size()
+                            : std::min(options.threads, pool.size());
+  const std::ptrdiff_t grain =
+      std::max<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(options.grain),
+                               detail::kMergeRunLength);
+  std::vector<T> buffer(n);
+  detail::note_allocation(comp, buffer.size() * sizeof(T));
+  auto buf = buffer.begin();
+  if (threads <= 1 || n <= grain) {
+    detail::merge_sort_buffered(first, last, buf, comp);
+    return;
+  }
+
+  // 1. 叶子块: 每个线程至少一块, 块内串行排序
+  const std::ptrdiff_t leaf = std::max<std::ptrdiff_t>(
+      grain, (n + static_cast<std::ptrdiff_t>(threads) - 1) /
+                 static_cast<std::ptrdiff_t>(threads));
+  const std::size_t leaves = static_cast<std::size_t>((n + leaf - 1) / leaf);
+  auto sort_leaf = [&](std::size_t t) {
+    std::ptrdiff_t lo = static_cast<std::ptrdiff_t>(t) * leaf;
+    std::ptrdiff_t hi = std::min(lo + leaf, n);
+    detail::merge_sort_buffered(first + lo, first + hi, buf + lo, comp);
+  };
+  // 每一步的任务数都可能多于 threads, 显式限制参与的线程数
+  pool.parallel_for(leaves, sort_leaf, threads);
+
+  // 2. 逐层归并: 每层输出按 piece 大小切分, 每段用 co-rank 定位输入
+  const std::ptrdiff_t piece = std::max<std::ptrdiff_t>(
+      grain, n / static_cast<std::ptrdiff_t>(threads * 4));
+  struct Task {
+    std::ptrdiff_t lo, mid, hi;    // 两个有序段 [lo, mid), [mid, hi)
+    std::ptrdiff_t out_lo, out_hi; // 本任务负责的输出偏移(相对 lo)
+  };
+  std::vector<Task> tasks;
+  bool in_buf = false;
+  for (std::ptrdiff_t width = leaf; width < n; width *= 2) {
+    tasks.clear();
+    for (std::ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+      std::ptrdiff_t mid = std::min(lo + width, n);
+      std::ptrdiff_t hi = std::min(lo + 2 * width, n);
+      for (std::ptrdiff_t k = 0; k < hi - lo; k += piece)
+        tasks.push_back({lo, mid, hi, k, std::min(k + piece, hi - lo)});
+    }
+    auto level = [&](auto src, auto dst) {
+      auto merge_piece = [&](std::size_t t) {
+        const Task &task = tasks[t];
+        auto a = src + task.lo, b = src + task.mid;
+        std::ptrdiff_t na = task.mid - task.lo, nb = task.hi - task.mid;
+        std::ptrdiff_t i0 = detail::co_rank(task.out_lo, a, na, b, nb, comp);
+        std::ptrdiff_t i1 = detail::co_rank(task.out_hi, a, na, b, nb, comp);
+        detail::merge_move(a + i0, a + i1, b + (task.out_lo - i0),
+                           b + (task.out_hi - i1),
+                           dst + task.lo + task.out_lo, comp);
+      };
+      pool.parallel_for(tasks.size(), merge_piece, threads);
+    };
+    if (in_buf)
+      level(buf, first);
+    else
+      level(first, buf);
+    in_buf = !in_buf;
+  }
+
+  // 3. 结果若停留在缓冲区, 并行搬回
+  if (in_buf) {
+    const std::size_t chunks =
+        static_cast<std::size_t>((n + piece - 1) / piece);
+    auto move_back = [&](std::size_t t) {
+      std::ptrdiff_t lo = static_cast<std::ptrdiff_t>(t) * piece;
+      std::ptrdiff_t hi = std::min(lo + piece, n);
+      std::move(buf + lo, buf + hi, first + lo);
+    };
+    pool.parallel_for(chunks, move_back, threads);
+  }
+}
+} // namespace ArrayUtils
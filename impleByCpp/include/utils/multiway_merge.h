@@ -0,0 +1,114 @@
+#pragma once
+// 多路归并: 把 k 个有序区间合并为一个有序序列, 基于败者树, 每个输出元素约 log2(k) 次比较
+// 小而可平凡复制的元素直接存入败者树结点, 其余类型在树中只保存指针
+// 稳定: 键相等时按区间在参数中的顺序输出
+#include "utils/loser_tree.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+template <typename T>
+inline constexpr bool kInlineLoserKey =
+    std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void *);
+
+template <typename T, typename Compare> struct DerefCompare {
+  Compare *comp;
+  bool operator()(const T *a, const T *b) const { return (*comp)(*a, *b); }
+};
+
+template <typename T, typename OutIt, typename Compare>
+OutIt multiway_merge_tree(std::span<const std::span<const T>> runs, OutIt out,
+                          Compare &comp) {
+  const std::size_t k = runs.size();
+  std::vector<const T *> cur(k), end(k);
+  for (std::size_t i = 0; i < k; ++i) {
+    cur[i] = runs[i].data();
+    end[i] = runs[i].data() + runs[i].size();
+  }
+  auto drain = [&](auto &tree, auto key_of, auto value_of) {
+    for (std::size_t i = 0; i < k; ++i)
+      if (cur[i] != end[i])
+        tree.set(i, key_of(cur[i]));
+    tree.build();
+    while (!tree.empty()) {
+      const std::size_t s = tree.top();
+      *out++ = value_of(tree.top_key());
+      if (++cur[s] == end[s])
+        tree.pop_top();
+      else
+        tree.replace_top(key_of(cur[s]));
+    }
+  };
+  if constexpr (kInlineLoserKey<T>) {
+    LoserTree<T, std::reference_wrapper<Compare>> tree(k, std::ref(comp));
+    drain(
+        tree, [](const T *p) -> const T & { return *p; },
+        [](const T &x) -> const T & { return x; });
+  } else {
+    LoserTree<const T *, DerefCompare<T, Compare>> tree(
+        k, DerefCompare<T, Compare>{&comp});
+    drain(
+        tree, [](const T *p) { return p; },
+        [](const T *p) -> const T & { return *p; });
+  }
+  return out;
+}
+} // namespace detail
+
+/**
+ * @brief 稳定多路归并
+ *
+ * @tparam T
+ * @tparam OutIt 输出迭代器, 输出区间不能与输入重叠
+ * @tparam Compare
+ * @param runs 各自按 comp 有序的区间
+ * @param out
+ * @param comp
+ * @return OutIt 输出尾后位置
+ */
+template <typename T, typename OutIt, typename Compare = std::less<>>
+OutIt multiway_merge(std::span<const std::span<const T>> runs, OutIt out,
+                     Compare comp = Compare{}) {
+  // 0/1/2 路不需要败者树
+  switch (runs.size()) {
+  case 0:
+    return out;
+  case 1:
+    return std::copy(runs[0].begin(), runs[0].end(), out);
+  case 2:
+    return std::merge(runs[0].begin(), runs[0].end(), runs[1].begin(),
+                      runs[1].end(), out, comp);
+  default:
+    return detail::multiway_merge_tree(runs, out, comp);
+  }
+}
+
+/**
+ * @brief 稳定多路归并, 返回新的有序数组
+ *
+ * @tparam T
+ * @tparam Compare
+ * @param runs 各自按 comp 有序的数组, 例如各分片的查询结果
+ * @param comp
+ * @return std::vector<T>
+ */
+template <typename T, typename Compare = std::less<>>
+std::vector<T> multiway_merge(const std::vector<std::vector<T>> &runs,
+                              Compare comp = Compare{}) {
+  std::vector<std::span<const T>> spans(runs.begin(), runs.end());
+  std::size_t total = 0;
+  for (const auto &run : runs)
+    total += run.size();
+  std::vector<T> result;
+  result.reserve(total);
+  multiway_merge<T>(std::span<const std::span<const T>>(spans),
+                    std::back_inserter(result), comp);
+  return result;
+}
+} // namespace ArrayUtils
@@ -0,0 +1,268 @@
+#pragma once
+// LSD基数排序: 可配置位宽(8/11/16 bit)的数位, 单块乒乓缓冲区
+// 一次遍历预先统计所有趟的直方图, 某一趟所有元素数位相同时直接跳过
+// 有符号整数与IEEE浮点数通过保序的键变换映射为无符号整数
+// 并行版本: 每线程独立直方图 + 前缀和分配互不重叠的输出区间 + 软件写合并缓冲
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+/**
+ * @brief 基数排序键变换: encode 把原值映射为保序的无符号整数
+ *
+ * @tparam T
+ */
+template <typename T> struct RadixTraits;
+
+template <std::unsigned_integral T> struct RadixTraits<T> {
+  using key_type = T;
+  static key_type encode(T x) { return x; }
+};
+
+// 有符号整数: 翻转符号位
+template <std::signed_integral T> struct RadixTraits<T> {
+  using key_type = std::make_unsigned_t<T>;
+  static key_type encode(T x) {
+    return static_cast<key_type>(x) ^
+           (key_type(1) << (sizeof(key_type) * 8 - 1));
+  }
+};
+
+// 浮点数: 负数翻转全部位, 非负数只翻转符号位
+template <std::floating_point T>
+  requires(sizeof(T) == 4 || sizeof(T) == 8)
+struct RadixTraits<T> {
+  using key_type =
+      std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+  static key_type encode(T x) {
+    constexpr key_type sign = key_type(1) << (sizeof(key_type) * 8 - 1);
+    key_type bits = std::bit_cast<key_type>(x);
+    return bits ^ ((bits & sign) ? ~key_type(0) : sign);
+  }
+};
+
+namespace detail {
+/**
+ * @brief LSD基数排序内核
+ *
+ * @tparam DigitBits 每趟处理的位数
+ * @tparam T 元素类型
+ * @tparam KeyFn 元素 -> 无符号整数键
+ * @param data 待排序数据
+ * @param buf 与 data 等长的乒乓缓冲区
+ * @param n
+ * @param key
+ */
+template <unsigned DigitBits, typename T, typename KeyFn>
+void lsd_radix_sort(T *data, T *buf, std::size_t n, KeyFn key) {
+  using K = std::remove_cvref_t<decltype(key(*data))>;
+  static_assert(std::unsigned_integral<K>, "radix key must be unsigned");
+  static_assert(DigitBits >= 1 && DigitBits <= 16, "unsupported digit width");
+  constexpr unsigned kKeyBits = sizeof(K) * 8;
+  constexpr unsigned kPasses = (kKeyBits + DigitBits - 1) / DigitBits;
+  constexpr std::size_t kRadix = std::size_t(1) << DigitBits;
+  constexpr K kMask = static_cast<K>(kRadix - 1);
+  if (n < 2)
+    return;
+
+  // 一次遍历统计所有趟的直方图
+  std::vector<std::size_t> hist(kPasses * kRadix, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    K k = key(data[i]);
+    for (unsigned p = 0; p < kPasses; ++p)
+      ++hist[p * kRadix + ((k >> (p * DigitBits)) & kMask)];
+  }
+
+  T *src = data, *dst = buf;
+  for (unsigned p = 0; p < kPasses; ++p) {
+    const unsigned shift = p * DigitBits;
+    std::size_t *count = hist.data() + p * kRadix;
+    // 平凡趟: 所有元素该数位相同, 排列不变
+    if (count[(key(src[0]) >> shift) & kMask] == n)
+      continue;
+
+    std::size_t sum = 0;
+    for (std::size_t d = 0; d < kRadix; ++d)
+      sum += std::exchange(count[d], sum);
+    for (std::size_t i = 0; i < n; ++i)
+      dst[count[(key(src[i]) >> shift) & kMask]++] = std::move(src[i]);
+    std::swap(src, dst);
+  }
+  if (src != data)
+    std::move(src, src + n, data);
+}
+
+/**
+ * @brief 并行LSD基数排序内核
+ * 数据按线程切成连续块; 每趟先并行统计各块直方图, 再按 (数位, 块) 顺序求前缀和,
+ * 使每个块写入互不重叠的输出区间, 无需加锁且保持稳定;
+ * 分发时先写入每个桶一条缓存行大小的本地缓冲区, 满了再整行写出, 减少缓存/TLB缺失
+ *
+ * @tparam DigitBits
+ * @tparam T
+ * @tparam KeyFn
+ * @param data
+ * @param buf 与 data 等长的乒乓缓冲区
+ * @param n
+ * @param key
+ * @param blocks 数据块数(即并行任务数)
+ * @param pool
+ */
+template <unsigned DigitBits, typename T, typename KeyFn>
+void parallel_lsd_radix_sort(T *data, T *buf, std::size_t n, KeyFn key,
+                             std::size_t blocks, ThreadPool &pool) {
+  using K = std::remove_cvref_t<decltype(key(*data))>;
+  static_assert(std::unsigned_integral<K>, "radix key must be unsigned");
+  static_assert(DigitBits >= 1 && DigitBits <= 16, "unsupported digit width");
+  constexpr unsigned kKeyBits = sizeof(K) * 8;
+  constexpr unsigned kPasses = (kKeyBits + DigitBits - 1) / DigitBits;
+  constexpr std::size_t kRadix = std::size_t(1) << DigitBits;
+  constexpr K kMask = static_cast<K>(kRadix - 1);
+  // 写合并缓冲: 每个桶一条64字节缓存行
+  constexpr std::size_t kLine = std::max<std::size_t>(1, 64 / sizeof(T));
+  if (n < 2)
+    return;
+
+  const std::size_t block = (n + blocks - 1) / blocks;
+  blocks = (n + block - 1) / block;
+  auto block_range = [&](std::size_t t) {
+    return std::pair<std::size_t, std::size_t>{t * block,
+                                               std::min(n, (t + 1) * block)};
+  };
+
+  // 并行统计全局直方图(所有趟), 用于跳过平凡趟
+  std::vector<std::size_t> local(blocks * kPasses * kRadix, 0);
+  pool.parallel_for(blocks, [&](std::size_t t) {
+    auto [lo, hi] = block_range(t);
+    std::size_t *h = local.data() + t * kPasses * kRadix;
+    for (std::size_t i = lo; i < hi; ++i) {
+      K k = key(data[i]);
+      for (unsigned p = 0; p < kPasses; ++p)
+        ++h[p * kRadix + ((k >> (p * DigitBits)) & kMask)];
+    }
+  });
+  std::vector<std::size_t> total(kPasses * kRadix, 0);
+  for (std::size_t t = 0; t < blocks; ++t)
+    for (std::size_t i = 0; i < kPasses * kRadix; ++i)
+      total[i] += local[t * kPasses * kRadix + i];
+
+  std::vector<std::size_t> count(blocks * kRadix);      // 每块直方图/写指针
+  std::vector<std::vector<T>> combine(blocks);          // 每块的写合并缓冲
+  std::vector<std::vector<std::uint32_t>> fill(blocks); // 缓冲区已填充数
+  T *src = data, *dst = buf;
+  for (unsigned p = 0; p < kPasses; ++p) {
+    const unsigned shift = p * DigitBits;
+    if (total[p * kRadix + ((key(src[0]) >> shift) & kMask)] == n)
+      continue;
+
+    // 1. 各块统计本趟直方图(上一趟之后块内数据已改变, 需重新统计)
+    pool.parallel_for(blocks, [&](std::size_t t) {
+      auto [lo, hi] = block_range(t);
+      std::size_t *h = count.data() + t * kRadix;
+      std::fill(h, h + kRadix, 0);
+      for (std::size_t i = lo; i < hi; ++i)
+        ++h[(key(src[i]) >> shift) & kMask];
+    });
+
+    // 2. 按 (数位, 块) 顺序求前缀和, 得到每块每个桶的起始写位置
+    std::size_t sum = 0;
+    for (std::size_t d = 0; d < kRadix; ++d)
+      for (std::size_t t = 0; t < blocks; ++t)
+        sum += std::exchange(count[t * kRadix + d], sum);
+
+    // 3. 经写合并缓冲分发
+    pool.parallel_for(blocks, [&](std::size_t t) {
+      auto [lo, hi] = block_range(t);
+      std::size_t *offset = count.data() + t * kRadix;
+      if (combine[t].empty()) {
+        combine[t].resize(kRadix * kLine);
+        fill[t].resize(kRadix);
+      }
+      T *wc = combine[t].data();
+      std::uint32_t *used = fill[t].data();
+      std::fill(used, used + kRadix, 0);
+      for (std::size_t i = lo; i < hi; ++i) {
+        std::size_t d = (key(src[i]) >> shift) & kMask;
+        wc[d * kLine + used[d]] = std::move(src[i]);
+        if (++used[d] == kLine) {
+          std::move(wc + d * kLine, wc + (d + 1) * kLine, dst + offset[d]);
+          offset[d] += kLine;
+          used[d] = 0;
+        }
+      }
+      for (std::size_t d = 0; d < kRadix; ++d)
+        std::move(wc + d * kLine, wc + d * kLine + used[d], dst + offset[d]);
+    });
+    std::swap(src, dst);
+  }
+  if (src != data) {
+    pool.parallel_for(blocks, [&](std::size_t t) {
+      auto [lo, hi] = block_range(t);
+      std::move(src + lo, src + hi, data + lo);
+    });
+  }
+}
+} // namespace detail
+
+/**
+ * @brief LSD基数排序(稳定), 支持有/无符号整数与 float/double
+ *
+ * @tparam DigitBits 每趟位宽, 常用 8/11/16
+ * @tparam ContiguousIt 连续存储迭代器
+ * @param first
+ * @param last
+ */
+template <unsigned DigitBits = 8, std::contiguous_iterator ContiguousIt>
+void radix_sort(ContiguousIt first, ContiguousIt last) {
+  using T = std::iter_value_t<ContiguousIt>;
+  const auto n = static_cast<std::size_t>(last - first);
+  if (n < 2)
+    return;
+  std::vector<T> buffer(n);
+  detail::lsd_radix_sort<DigitBits>(
+      std::to_address(first), buffer.data(), n,
+      [](const T &x) { return RadixTraits<T>::encode(x); });
+}
+
+/**
+ * @brief 并行LSD基数排序(稳定), 适用于内存带宽受限的大批量整数键
+ *
+ * @tparam DigitBits 每趟位宽
+ * @tparam ContiguousIt 连续存储迭代器
+ * @param first
+ * @param last
+ * @param options 并发度与任务粒度
+ * @param pool 执行所用线程池
+ */
+template <unsigned DigitBits = 8, std::contiguous_iterator ContiguousIt>
+void parallel_radix_sort(ContiguousIt first, ContiguousIt last,
+                         const ParallelSortOptions &options = {},
+                         ThreadPool &pool = ThreadPool::instance()) {
+  using T = std::iter_value_t<ContiguousIt>;
+  const auto n = static_cast<std::size_t>(last - first);
+  if (n < 2)
+    return;
+  std::size_t threads = options.threads == 0
+                            ? pool.size()
+                            : std::min(options.threads, pool.size());
+  const std::size_t grain = std::max<std::size_t>(options.grain, 1);
+  const std::size_t blocks = std::min(threads, (n + grain - 1) / grain);
+  std::vector<T> buffer(n);
+  auto encode = [](const T &x) { return RadixTraits<T>::encode(x); };
+  if (blocks <= 1)
+    detail::lsd_radix_sort<DigitBits>(std::to_address(first), buffer.data(),
+                                      n, encode);
+  else
+    detail::parallel_lsd_radix_sort<DigitBits>(
+        std::to_address(first), buffer.data(), n, encode, blocks, pool);
+}
+} // namespace ArrayUtils
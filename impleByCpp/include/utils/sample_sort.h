@@ -0,0 +1,195 @@
+#pragma once
+// 并行样本排序(sample sort): 过采样选出分割点 -> 各线程用无分支搜索树给本段元素分桶
+// -> 线程局部直方图求前缀和后分发 -> 各桶独立排序
+// 分桶阶段没有任何共享写入与锁; 分割点重复时启用"相等桶", 其中元素无需再排序
+#include "utils/introsort.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::size_t kMaxSampleBuckets = 256;   // 最多桶数(不含相等桶)
+inline constexpr std::size_t kClassifyBatch = 8;        // 交错分类的元素数
+inline constexpr std::size_t kSampleSortMinimum = 4096; // 低于此规模直接串行排序
+
+/**
+ * @brief 分割点搜索树: 有序分割点按 Eytzinger(BFS)顺序存放, 下降过程只有比较结果参与下标计算
+ */
+template <typename T, typename Compare> class SplitterTree {
+public:
+  /**
+   * @param splitters 有序分割点, 个数为 buckets - 1
+   * @param buckets 桶数, 2的幂
+   */
+  SplitterTree(const std::vector<T> &splitters, std::size_t buckets,
+               Compare &comp, bool equal_buckets)
+      : log_buckets_(std::bit_width(buckets) - 1), tree_(buckets),
+        sorted_(splitters), comp_(comp), equal_buckets_(equal_buckets) {
+    std::size_t next = 0;
+    fill(1, next);
+  }
+
+  // 桶编号的上界(不含)
+  std::size_t bucket_count() const {
+    return equal_buckets_ ? 2 * tree_.size() : tree_.size();
+  }
+
+  /**
+   * @brief 给 [first, first + n) 中的元素分桶, 结果写入 out
+   * 每批 kClassifyBatch 个元素同层交错下降, 各元素的访存与比较可以重叠
+   */
+  template <typename It>
+  void classify(It first, std::size_t n, std::uint16_t *out) const {
+    const std::size_t buckets = tree_.size();
+    std::size_t i = 0;
+    for (; i + kClassifyBatch <= n; i += kClassifyBatch) {
+      std::size_t idx[kClassifyBatch];
+      for (std::size_t j = 0; j < kClassifyBatch; ++j)
+        idx[j] = 1;
+      for (unsigned level = 0; level < log_buckets_; ++level)
+        for (std::size_t j = 0; j < kClassifyBatch; ++j)
+          idx[j] = 2 * idx[j] + comp_(tree_[idx[j]], *(first + (i + j)));
+      for (std::size_t j = 0; j < kClassifyBatch; ++j)
+        out[i + j] = finish(idx[j] - buckets, *(first + (i + j)));
+    }
+    for (; i < n; ++i) {
+      std::size_t idx = 1;
+      for (unsigned level = 0; level < log_buckets_; ++level)
+        idx = 2 * idx + comp_(tree_[idx], *(first + i));
+      out[i] = finish(idx - buckets, *(first + i));
+    }
+  }
+
+private:
+  void fill(std::size_t node, std::size_t &next) {
+    if (node >= tree_.size())
+      return;
+    fill(2 * node, next);
+    tree_[node] = sorted_[next++];
+    fill(2 * node + 1, next);
+  }
+
+  // b 为小于 x 的分割点个数; 与第 b 个分割点相等时落入相等桶 2b + 1
+  std::uint16_t finish(std::size_t b, const T &x) const {
+    if (!equal_buckets_)
+      return static_cast<std::uint16_t>(b);
+    const bool equal = b < sorted_.size() && !comp_(x, sorted_[b]);
+    return static_cast<std::uint16_t>(2 * b + equal);
+  }
+
+  unsigned log_buckets_;
+  std::vector<T> tree_; // tree_[1..buckets)
+  const std::vector<T> &sorted_;
+  Compare &comp_;
+  bool equal_buckets_;
+};
+} // namespace detail
+
+/**
+ * @brief 并行样本排序(不稳定)
+ * 需要 n 个元素的辅助空间; 辅助空间不做初始化, 由各线程分发时首次写入,
+ * 在 NUMA 机器上页面会落在实际使用它的结点上
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param comp
+ * @param options 并发度与任务粒度
+ * @param pool 执行所用线程池
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_sample_sort(RandomIt first, RandomIt last,
+                          Compare comp = Compare{},
+                          const ParallelSortOptions &options = {},
+                          ThreadPool &pool = ThreadPool::instance()) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  const std::size_t n = static_cast<std::size_t>(last - first);
+  std::size_t threads = options.threads == 0
+                            ? pool.size()
+                            : std::min(options.threads, pool.size());
+  const std::size_t grain = std::max<std::size_t>(options.grain, 1);
+  const std::size_t blocks = std::min(threads, (n + grain - 1) / grain);
+  if (blocks <= 1 || n < detail::kSampleSortMinimum) {
+    introsort(first, last, comp, PartitionScheme::simd);
+    return;
+  }
+
+  // 1. 过采样: 每个桶 oversample 个样本, 等距取 buckets - 1 个分割点
+  const std::size_t buckets = std::clamp<std::size_t>(
+      std::bit_ceil(4 * blocks), 2, detail::kMaxSampleBuckets);
+  const std::size_t oversample =
+      std::max<std::size_t>(2, std::bit_width(n) / 5);
+  std::vector<T> sample(buckets * oversample);
+  std::mt19937_64 rng(n);
+  for (auto &s : sample)
+    s = *(first + static_cast<std::ptrdiff_t>(rng() % n));
+  introsort(sample.begin(), sample.end(), comp);
+  std::vector<T> splitters(buckets - 1);
+  bool duplicates = false;
+  for (std::size_t i = 0; i + 1 < buckets; ++i) {
+    splitters[i] = sample[(i + 1) * oversample - 1];
+    duplicates |= i > 0 && !comp(splitters[i - 1], splitters[i]);
+  }
+  const detail::SplitterTree<T, Compare> tree(splitters, buckets, comp,
+                                              duplicates);
+  const std::size_t ids = tree.bucket_count();
+
+  // 2. 各块分类并统计局部直方图
+  auto block_range = [&](std::size_t t) {
+    return std::pair{n * t / blocks, n * (t + 1) / blocks};
+  };
+  auto oracle = std::make_unique_for_overwrite<std::uint16_t[]>(n);
+  std::vector<std::size_t> count(blocks * ids, 0);
+  pool.parallel_for(blocks, [&](std::size_t t) {
+    auto [lo, hi] = block_range(t);
+    tree.classify(first + static_cast<std::ptrdiff_t>(lo), hi - lo,
+                  oracle.get() + lo);
+    std::size_t *h = count.data() + t * ids;
+    for (std::size_t i = lo; i < hi; ++i)
+      ++h[oracle[i]];
+  });
+
+  // 3. 按 (桶, 块) 顺序求前缀和, 得到每块每个桶的写位置, 并记录各桶边界
+  std::vector<std::size_t> bucket_begin(ids + 1);
+  std::size_t sum = 0;
+  for (std::size_t b = 0; b < ids; ++b) {
+    bucket_begin[b] = sum;
+    for (std::size_t t = 0; t < blocks; ++t)
+      sum += std::exchange(count[t * ids + b], sum);
+  }
+  bucket_begin[ids] = n;
+
+  // 4. 分发到辅助空间
+  auto buffer = std::make_unique_for_overwrite<T[]>(n);
+  pool.parallel_for(blocks, [&](std::size_t t) {
+    auto [lo, hi] = block_range(t);
+    std::size_t *offset = count.data() + t * ids;
+    for (std::size_t i = lo; i < hi; ++i)
+      buffer[offset[oracle[i]]++] =
+          std::move(*(first + static_cast<std::ptrdiff_t>(i)));
+  });
+  oracle.reset();
+
+  // 5. 各桶独立排序后搬回原位; 线程池动态领取任务, 大小不均的桶也能负载均衡
+  // 桶数多于 threads, 显式限制参与的线程数
+  auto sort_bucket = [&](std::size_t b) {
+    T *lo = buffer.get() + bucket_begin[b];
+    T *hi = buffer.get() + bucket_begin[b + 1];
+    const bool equal_bucket = duplicates && b % 2 == 1;
+    if (!equal_bucket)
+      introsort(lo, hi, comp, PartitionScheme::simd);
+    std::move(lo, hi, first + static_cast<std::ptrdiff_t>(bucket_begin[b]));
+  };
+  pool.parallel_for(ids, sort_bucket, threads);
+}
+} // namespace ArrayUtils
@@ -0,0 +1,134 @@
+#pragma once
+// 选择算法: 不完整排序即可得到第k小元素或前k小元素
+// nth_element 为内省选择: 平时用快速选择, 划分轮数过多时改用中位数的中位数选枢轴, 最坏 O(n)
+// partial_sort: k 远小于 n 时用大小为k的堆筛选, 否则先选择再排序前k个
+#include "utils/introsort.h"
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
+namespace ArrayUtils {
+namespace detail {
+inline constexpr std::ptrdiff_t kHeapSelectRatio = 64; // k * 64 <= n 时用堆筛选
+
+template <typename RandomIt, typename Compare>
+void introselect(RandomIt first, RandomIt nth, RandomIt last, Compare &comp,
+                 PartitionScheme scheme, int depth_limit);
+
+/**
+ * @brief 中位数的中位数: 把一个保证位于 30%~70% 分位之间的元素放到 *first
+ * 每5个一组取中位数, 集中到区间前部后递归选择其中位数
+ */
+template <typename RandomIt, typename Compare>
+void median_of_medians(RandomIt first, RandomIt last, Compare &comp) {
+  RandomIt medians = first;
+  for (RandomIt group = first; group < last; group += 5) {
+    RandomIt end = last - group > 5 ? group + 5 : last;
+    insertion_sort(group, end, comp);
+    std::iter_swap(medians++, group + (end - group - 1) / 2);
+    if (end == last)
+      break;
+  }
+  RandomIt mid = first + (medians - first - 1) / 2;
+  introselect(first, mid, medians, comp, PartitionScheme::hoare, 0);
+  std::iter_swap(first, mid);
+}
+
+/**
+ * @brief 内省选择循环, depth_limit 为0时每轮都用中位数的中位数选枢轴
+ */
+template <typename RandomIt, typename Compare>
+void introselect(RandomIt first, RandomIt nth, RandomIt last, Compare &comp,
+                 PartitionScheme scheme, int depth_limit) {
+  while (last - first > kSmallRangeThreshold<RandomIt, Compare>) {
+    if (depth_limit > 0) {
+      --depth_limit;
+      choose_pivot(first, last, comp);
+    } else {
+      median_of_medians(first, last, comp);
+      scheme = PartitionScheme::hoare;
+    }
+    auto [lo, hi] = partition_range(first, last, comp, scheme);
+    if (nth < lo)
+      last = lo;
+    else if (nth >= hi)
+      first = hi;
+    else
+      return;
+  }
+  small_range_sort(first, last, comp);
+}
+
+/**
+ * @brief 堆筛选: [first, middle) 建为大顶堆, 扫描其余元素, 比堆顶小则替换堆顶
+ * 执行后 [first, middle) 为前k小元素(无序)
+ */
+template <typename RandomIt, typename Compare>
+void heap_select(RandomIt first, RandomIt middle, RandomIt last,
+                 Compare &comp) {
+  const std::ptrdiff_t k = middle - first;
+  for (std::ptrdiff_t i = k / 2 - 1; i >= 0; --i)
+    sift_down(first, k, i, comp);
+  for (RandomIt it = middle; it != last; ++it) {
+    if (comp(*it, *first)) {
+      std::iter_swap(it, first);
+      sift_down(first, k, 0, comp);
+    }
+  }
+}
+} // namespace detail
+
+/**
+ * @brief 内省选择(introselect): 执行后 *nth 为完整排序时该位置的元素,
+ * [first, nth) 不大于 *nth, (nth, last) 不小于 *nth
+ * 划分轮数超过 2logn 时改用中位数的中位数选枢轴, 保证最坏 O(n)
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param nth
+ * @param last
+ * @param comp
+ * @param scheme 分区策略
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void nth_element(RandomIt first, RandomIt nth, RandomIt last,
+                 Compare comp = Compare{},
+                 PartitionScheme scheme = PartitionScheme::hoare) {
+  if (nth == last || last - first < 2)
+    return;
+  const auto n = static_cast<std::size_t>(last - first);
+  detail::introselect(first, nth, last, comp, scheme,
+                      2 * static_cast<int>(std::bit_width(n)));
+}
+
+/**
+ * @brief 部分排序(不稳定): 执行后 [first, middle) 为前k小元素且有序, 其余元素顺序未定
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param middle
+ * @param last
+ * @param comp
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last,
+                  Compare comp = Compare{}) {
+  const std::ptrdiff_t k = middle - first;
+  if (k <= 0)
+    return;
+  if (k * detail::kHeapSelectRatio <= last - first) {
+    detail::heap_select(first, middle, last, comp);
+    detail::heap_sort(first, middle, comp);
+    return;
+  }
+  if (middle == last) {
+    introsort(first, last, comp);
+    return;
+  }
+  ArrayUtils::nth_element(first, middle - 1, last, comp);
+  introsort(first, middle - 1, comp);
+}
+} // namespace ArrayUtils
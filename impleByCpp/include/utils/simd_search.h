@@ -0,0 +1,47 @@
+#pragma once
+// 向量化查找(int):
+// 线性查找: 每轮比较32个元素, 合并比较掩码后只做一次判断, 命中后再定位具体下标
+// 有序数组查找: 16路(k叉)查找, 每轮取16个等距分隔元素一起比较, 数出小于目标的个数即得子区间,
+//   区间缩小为 1/17; 16次读取互不依赖, 访存可以重叠; 区间不超过阈值后改为向量计数(无分支)
+// 运行时检测CPU: 支持AVX2时使用向量内核, 否则使用同样算法的标量实现
+#include <cstddef>
+
+namespace SearchUtils {
+/**
+ * @brief 线性查找第一个等于 target 的元素
+ *
+ * @param data
+ * @param n
+ * @param target
+ * @return std::size_t 下标, 不存在时返回 n
+ */
+std::size_t simd_find(const int *data, std::size_t n, int target);
+
+/**
+ * @brief 有序(升序)数组中第一个不小于 target 的元素下标, 不存在时返回 n
+ * 16路查找, 区间不超过 detail::kLinearSearchMax 后改为向量计数
+ *
+ * @param data
+ * @param n
+ * @param target
+ * @return std::size_t
+ */
+std::size_t simd_lower_bound(const int *data, std::size_t n, int target);
+
+/**
+ * @brief 当前进程是否使用AVX2内核
+ */
+bool simd_search_uses_avx2();
+
+namespace detail {
+inline constexpr std::size_t kKaryFanout = 16; // 每轮比较的分隔元素个数
+// 不超过此长度时直接计数; 实测(32/64/128/256)越小越快, gather 一轮的代价与计数16个元素相当
+inline constexpr std::size_t kLinearSearchMax = 16;
+static_assert(kLinearSearchMax >= kKaryFanout, "每轮每段至少一个元素");
+
+// 标量版本(不做CPU检测), 便于对照测试
+std::size_t simd_find_scalar(const int *data, std::size_t n, int target);
+std::size_t simd_lower_bound_scalar(const int *data, std::size_t n,
+                                    int target);
+} // namespace detail
+} // namespace SearchUtils
@@ -0,0 +1,73 @@
+#pragma once
+// 小数组排序网络: 对不超过64个 int/float 做双调(bitonic)排序
+// 向量化分区: 查表置换 + 压缩存储, 从两端交替读取实现原地分区
+// 向量化 min/max: 多个累加寄存器并行归约, 供计数排序确定值域
+// 运行时检测CPU: 支持AVX2时使用向量内核, 否则使用无分支的标量实现
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace ArrayUtils {
+inline constexpr std::size_t kSmallSortMax = 64; // 排序网络支持的最大元素数
+
+/**
+ * @brief 小数组升序排序, n <= kSmallSortMax; 不支持NaN
+ *
+ * @param data
+ * @param n
+ */
+void small_sort(int *data, std::size_t n);
+void small_sort(float *data, std::size_t n);
+
+/**
+ * @brief 按枢轴原地分区(不稳定): x < pivot 的元素移到前部
+ *
+ * @param data
+ * @param n
+ * @param pivot
+ * @param inclusive 为 true 时改为 x <= pivot 的元素移到前部
+ * @return std::size_t 前部元素个数
+ */
+std::size_t simd_partition(int *data, std::size_t n, int pivot,
+                           bool inclusive = false);
+std::size_t simd_partition(float *data, std::size_t n, float pivot,
+                           bool inclusive = false);
+
+/**
+ * @brief 一次遍历同时求最小值与最大值, n > 0
+ *
+ * @param data
+ * @param n
+ * @return std::pair<int, int> {最小值, 最大值}
+ */
+std::pair<int, int> simd_minmax(const int *data, std::size_t n);
+
+/**
+ * @brief 当前进程是否使用AVX2内核
+ */
+bool simd_sort_uses_avx2();
+
+namespace detail {
+// 标量版本(不做CPU检测), 便于对照测试
+void small_sort_scalar(int *data, std::size_t n);
+void small_sort_scalar(float *data, std::size_t n);
+std::size_t simd_partition_scalar(int *data, std::size_t n, int pivot,
+                                  bool inclusive);
+std::size_t simd_partition_scalar(float *data, std::size_t n, float pivot,
+                                  bool inclusive);
+std::pair<int, int> simd_minmax_scalar(const int *data, std::size_t n);
+
+// 连续存储的 int/float 且按 std::less 升序时, 小区间可交给排序网络
+template <typename RandomIt, typename Compare>
+inline constexpr bool kHasSmallSort =
+    std::contiguous_iterator<RandomIt> &&
+    (std::same_as<std::iter_value_t<RandomIt>, int> ||
+     std::same_as<std::iter_value_t<RandomIt>, float>) &&
+    (std::same_as<std::remove_cvref_t<Compare>, std::less<>> ||
+     std::same_as<std::remove_cvref_t<Compare>,
+                  std::less<std::iter_value_t<RandomIt>>>);
+} // namespace detail
+} // namespace ArrayUtils
@@ -1,3 +1,4 @@
+#include "utils/multiway_merge.h"
 #include <iostream>
 #include <memory>
 #include <random>
@@ -292,6 +293,29 @@ SkipList<Key, Value>::rangeQuery(const Key &start, const Key &end) const {
   return result;
 }
 
+/**
+ * @brief 对多个跳表(如各分片)做同一范围查询, 并按键多路归并为一个有序结果
+ * 键相等时按跳表在参数中的顺序输出
+ *
+ * @tparam Key
+ * @tparam Value
+ * @param lists
+ * @param start
+ * @param end
+ * @return std::vector<std::pair<Key, Value>>
+ */
+template <typename Key, typename Value>
+std::vector<std::pair<Key, Value>>
+mergeRangeQueries(const std::vector<const SkipList<Key, Value> *> &lists,
+                  const Key &start, const Key &end) {
+  std::vector<std::vector<std::pair<Key, Value>>> results;
+  results.reserve(lists.size());
+  for (const auto *list : lists)
+    results.push_back(list->rangeQuery(start, end));
+  return ArrayUtils::multiway_merge(
+      results, [](const auto &a, const auto &b) { return a.first < b.first; });
+}
+
 /**
  * @brief 跳表大小
  *
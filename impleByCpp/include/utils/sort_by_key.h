@@ -0,0 +1,174 @@
+#pragma once
+// 键值排序: 只对 (键, 下标) 排序得到置换(argsort), 最后一次性按置换搬动大对象
+// 提供 introsort / 稳定归并 / 基数排序三种内核
+#include "utils/introsort.h"
+#include "utils/merge_sort.h"
+#include "utils/radix_sort.h"
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+namespace detail {
+template <typename K> struct KeyIndex {
+  K key;
+  std::size_t index;
+};
+
+// 把投影后的键与原下标打包, 使排序时只搬动小对象且访问连续
+template <typename RandomIt, typename Proj>
+auto make_key_index(RandomIt first, RandomIt last, Proj &proj) {
+  using K = std::remove_cvref_t<std::invoke_result_t<
+      Proj &, typename std::iterator_traits<RandomIt>::reference>>;
+  std::vector<KeyIndex<K>> pairs;
+  pairs.reserve(static_cast<std::size_t>(last - first));
+  std::size_t i = 0;
+  for (RandomIt it = first; it != last; ++it)
+    pairs.push_back({std::invoke(proj, *it), i++});
+  return pairs;
+}
+
+template <typename K>
+std::vector<std::size_t> indices_of(const std::vector<KeyIndex<K>> &pairs) {
+  std::vector<std::size_t> perm(pairs.size());
+  for (std::size_t i = 0; i < pairs.size(); ++i)
+    perm[i] = pairs[i].index;
+  return perm;
+}
+} // namespace detail
+
+/**
+ * @brief 按置换原地重排: 执行后 new[i] = old[perm[i]], 每个元素只移动一次
+ *
+ * @tparam RandomIt
+ * @param first
+ * @param last
+ * @param perm 0..n-1 的一个排列
+ */
+template <typename RandomIt>
+void apply_permutation(RandomIt first, RandomIt last,
+                       const std::vector<std::size_t> &perm) {
+  const auto n = static_cast<std::size_t>(last - first);
+  if (perm.size() != n)
+    throw std::invalid_argument("permutation size does not match range");
+  std::vector<bool> done(n, false);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (done[i] || perm[i] == i)
+      continue;
+    // 沿置换环移动, 环首元素暂存
+    auto tmp = std::move(*(first + i));
+    std::size_t j = i;
+    while (true) {
+      std::size_t k = perm[j];
+      done[j] = true;
+      if (k == i) {
+        *(first + j) = std::move(tmp);
+        break;
+      }
+      *(first + j) = std::move(*(first + k));
+      j = k;
+    }
+  }
+}
+
+/**
+ * @brief argsort(不稳定, introsort内核)
+ *
+ * @tparam RandomIt
+ * @tparam Compare 作用于投影后的键
+ * @tparam Proj 元素 -> 键
+ * @return std::vector<std::size_t> 排序后第i个元素的原下标
+ */
+template <typename RandomIt, typename Compare = std::less<>,
+          typename Proj = std::identity>
+std::vector<std::size_t> argsort(RandomIt first, RandomIt last,
+                                 Compare comp = Compare{},
+                                 Proj proj = Proj{}) {
+  auto pairs = detail::make_key_index(first, last, proj);
+  introsort(pairs.begin(), pairs.end(),
+            [&](const auto &a, const auto &b) { return comp(a.key, b.key); });
+  return detail::indices_of(pairs);
+}
+
+/**
+ * @brief 稳定argsort(归并排序内核)
+ */
+template <typename RandomIt, typename Compare = std::less<>,
+          typename Proj = std::identity>
+std::vector<std::size_t> stable_argsort(RandomIt first, RandomIt last,
+                                        Compare comp = Compare{},
+                                        Proj proj = Proj{}) {
+  auto pairs = detail::make_key_index(first, last, proj);
+  decltype(pairs) buffer(pairs.size());
+  auto key_comp = [&](const auto &a, const auto &b) {
+    return comp(a.key, b.key);
+  };
+  detail::merge_sort_buffered(pairs.begin(), pairs.end(), buffer.begin(),
+                              key_comp);
+  return detail::indices_of(pairs);
+}
+
+/**
+ * @brief 稳定argsort(LSD基数排序内核), 键须为整数或浮点数
+ */
+template <unsigned DigitBits = 8, typename RandomIt,
+          typename Proj = std::identity>
+std::vector<std::size_t> radix_argsort(RandomIt first, RandomIt last,
+                                       Proj proj = Proj{}) {
+  using K = std::remove_cvref_t<std::invoke_result_t<
+      Proj &, typename std::iterator_traits<RandomIt>::reference>>;
+  auto encoded = [&](const auto &x) {
+    return RadixTraits<K>::encode(std::invoke(proj, x));
+  };
+  auto pairs = detail::make_key_index(first, last, encoded);
+  decltype(pairs) buffer(pairs.size());
+  detail::lsd_radix_sort<DigitBits>(pairs.data(), buffer.data(), pairs.size(),
+                                    [](const auto &p) { return p.key; });
+  return detail::indices_of(pairs);
+}
+
+/**
+ * @brief 键数组与值数组(等长)按键排序(不稳定)
+ *
+ * @param keys_first
+ * @param keys_last
+ * @param values_first 值数组起点
+ * @param comp
+ */
+template <typename KeyIt, typename ValueIt, typename Compare = std::less<>>
+void sort_by_key(KeyIt keys_first, KeyIt keys_last, ValueIt values_first,
+                 Compare comp = Compare{}) {
+  auto perm = argsort(keys_first, keys_last, comp);
+  apply_permutation(keys_first, keys_last, perm);
+  apply_permutation(values_first, values_first + (keys_last - keys_first),
+                    perm);
+}
+
+/**
+ * @brief 键数组与值数组按键稳定排序(归并排序内核)
+ */
+template <typename KeyIt, typename ValueIt, typename Compare = std::less<>>
+void stable_sort_by_key(KeyIt keys_first, KeyIt keys_last,
+                        ValueIt values_first, Compare comp = Compare{}) {
+  auto perm = stable_argsort(keys_first, keys_last, comp);
+  apply_permutation(keys_first, keys_last, perm);
+  apply_permutation(values_first, values_first + (keys_last - keys_first),
+                    perm);
+}
+
+/**
+ * @brief 键数组与值数组按键稳定排序(基数排序内核)
+ */
+template <unsigned DigitBits = 8, typename KeyIt, typename ValueIt>
+void radix_sort_by_key(KeyIt keys_first, KeyIt keys_last,
+                       ValueIt values_first) {
+  auto perm = radix_argsort<DigitBits>(keys_first, keys_last);
+  apply_permutation(keys_first, keys_last, perm);
+  apply_permutation(values_first, values_first + (keys_last - keys_first),
+                    perm);
+}
+} // namespace ArrayUtils
@@ -0,0 +1,140 @@
+#pragma once
+// 排序插桩: 统计比较次数、元素移动次数、递归深度与堆分配, 用于按负载挑选算法
+// 以比较器类型作为编译期策略: 各排序在递归与分配处调用 note_depth / note_allocation,
+// 普通比较器下这些钩子是空函数, 编译后不留痕迹; 传入 CountingCompare 时才会计数
+// 元素移动无法从比较器观察, 需把元素包装为 Counted<T>, measure_sort 会自动完成
+// 注意: 插桩模式下 int/float 不再走排序网络和向量化分区, 统计的是通用路径; 仅支持串行排序
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+struct SortStats {
+  std::size_t comparisons = 0;     // 比较次数
+  std::size_t moves = 0;           // 元素移动/拷贝次数(需 Counted<T>)
+  std::size_t max_depth = 0;       // 最大递归深度(归并类为归并层数)
+  std::size_t allocations = 0;     // 堆分配次数
+  std::size_t allocated_bytes = 0; // 堆分配总字节数
+};
+
+/**
+ * @brief 计数比较器: 每次比较累加 stats.comparisons, 并让排序内部的钩子生效
+ *
+ * @tparam Compare 被包装的比较器
+ */
+template <typename Compare = std::less<>> class CountingCompare {
+public:
+  explicit CountingCompare(SortStats &stats, Compare comp = Compare{})
+      : comp_(std::move(comp)), stats_(&stats) {}
+
+  template <typename A, typename B> bool operator()(const A &a, const B &b) {
+    ++stats_->comparisons;
+    return comp_(a, b);
+  }
+
+  SortStats &stats() const { return *stats_; }
+
+private:
+  Compare comp_;
+  SortStats *stats_;
+};
+
+namespace detail {
+template <typename Compare> inline constexpr bool kInstrumented = false;
+template <typename Compare>
+inline constexpr bool kInstrumented<CountingCompare<Compare>> = true;
+
+// 当前线程上 Counted<T> 计数的目标, 为空时不计数
+inline thread_local SortStats *counted_stats = nullptr;
+
+/**
+ * @brief 上报当前递归深度(从1开始)
+ */
+template <typename Compare>
+inline void note_depth([[maybe_unused]] const Compare &comp,
+                       [[maybe_unused]] std::size_t depth) {
+  if constexpr (kInstrumented<Compare>)
+    comp.stats().max_depth = std::max(comp.stats().max_depth, depth);
+}
+
+/**
+ * @brief 上报一次堆分配
+ */
+template <typename Compare>
+inline void note_allocation([[maybe_unused]] const Compare &comp,
+                            [[maybe_unused]] std::size_t bytes) {
+  if constexpr (kInstrumented<Compare>) {
+    ++comp.stats().allocations;
+    comp.stats().allocated_bytes += bytes;
+  }
+}
+} // namespace detail
+
+/**
+ * @brief 计数元素: 拷贝/移动时累加当前线程的 SortStats::moves
+ * 可隐式转换为 const T&, 原有比较器无需修改
+ */
+template <typename T> class Counted {
+public:
+  Counted() = default;
+  Counted(const T &value) : value_(value) {}
+  Counted(const Counted &other) : value_(other.value_) { count(); }
+  Counted(Counted &&other) noexcept : value_(std::move(other.value_)) {
+    count();
+  }
+  Counted &operator=(const Counted &other) {
+    value_ = other.value_;
+    count();
+    return *this;
+  }
+  Counted &operator=(Counted &&other) noexcept {
+    value_ = std::move(other.value_);
+    count();
+    return *this;
+  }
+
+  operator const T &() const { return value_; }
+  const T &value() const { return value_; }
+
+  friend bool operator<(const Counted &a, const Counted &b) {
+    return a.value_ < b.value_;
+  }
+  friend bool operator>(const Counted &a, const Counted &b) {
+    return b.value_ < a.value_;
+  }
+
+private:
+  static void count() {
+    if (detail::counted_stats != nullptr)
+      ++detail::counted_stats->moves;
+  }
+
+  T value_{};
+};
+
+/**
+ * @brief 以插桩模式运行一次排序并返回统计, 不修改 values
+ *
+ * @tparam T
+ * @tparam SortFn 形如 sort(first, last, comp) 的可调用对象
+ * @tparam Compare
+ * @param values 输入
+ * @param sort 被测排序
+ * @param comp
+ * @return SortStats
+ */
+template <typename T, typename SortFn, typename Compare = std::less<>>
+SortStats measure_sort(const std::vector<T> &values, SortFn &&sort,
+                       Compare comp = Compare{}) {
+  std::vector<Counted<T>> data(values.begin(), values.end());
+  SortStats stats;
+  struct Scope { // 排序抛异常时也要恢复计数目标
+    SortStats *saved;
+    ~Scope() { detail::counted_stats = saved; }
+  } scope{std::exchange(detail::counted_stats, &stats)};
+  sort(data.begin(), data.end(), CountingCompare<Compare>(stats, comp));
+  return stats;
+}
+} // namespace ArrayUtils
@@ -0,0 +1,85 @@
+#pragma once
+// 静态B+树(S+树, int): 对只读有序数组建立隐式B+树, 每个节点16个键恰好占一个缓存行
+// 叶子层就是有序数组本身(按16个一组补齐), 其上各层的键为右侧子树的最小键,
+// 节点 k 的第 i 个子节点为下一层的 k * 17 + i, 不存指针; 查找时每层只读一个缓存行,
+// 节点内用向量比较数出小于目标的键数即得子节点序号, 没有分支
+// 树高 log17(n), 100M 个元素只需7层, 而二分查找要访问约27个缓存行
+// 存储按缓存行对齐, 不小于2MB时按2MB对齐并建议内核使用透明大页, 减少TLB未命中
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace SearchUtils {
+class StaticBTree;
+
+namespace detail {
+inline constexpr std::size_t kBTreeNodeKeys = 16; // 每个节点的键数, 一个缓存行
+inline constexpr std::size_t kHugePage = std::size_t(1) << 21;
+
+// 标量版本(不做CPU检测), 便于对照测试
+std::size_t static_btree_lower_bound_scalar(const StaticBTree &tree, int x);
+} // namespace detail
+
+class StaticBTree {
+public:
+  using const_iterator = const int *;
+
+  StaticBTree() = default;
+
+  /**
+   * @brief 由升序数组构建, 允许重复元素
+   *
+   * @param sorted
+   * @param n
+   */
+  StaticBTree(const int *sorted, std::size_t n);
+  explicit StaticBTree(const std::vector<int> &sorted);
+  StaticBTree(StaticBTree &&other) noexcept;
+  StaticBTree &operator=(StaticBTree &&other) noexcept;
+  StaticBTree(const StaticBTree &) = delete;
+  StaticBTree &operator=(const StaticBTree &) = delete;
+  ~StaticBTree();
+
+  std::size_t size() const { return n_; }
+  bool empty() const { return n_ == 0; }
+
+  /**
+   * @brief 第一个不小于 x 的元素的下标, 不存在时返回 size()
+   */
+  std::size_t lower_bound(int x) const;
+
+  /**
+   * @brief 第一个大于 x 的元素的下标, 不存在时返回 size()
+   */
+  std::size_t upper_bound(int x) const;
+
+  bool contains(int x) const;
+
+  /**
+   * @brief 键在 [lo, hi) 内的全部元素, 按升序
+   */
+  std::span<const int> range(int lo, int hi) const;
+
+  // 叶子层即原有序数组, 可直接按序遍历
+  const_iterator begin() const { return keys_; }
+  const_iterator end() const { return keys_ + n_; }
+  int operator[](std::size_t i) const { return keys_[i]; }
+
+private:
+  friend std::size_t detail::static_btree_lower_bound_scalar(
+      const StaticBTree &tree, int x);
+
+  void release();
+
+  int *keys_ = nullptr;              // 各层依次存放, 叶子层在最前
+  std::size_t n_ = 0;
+  std::size_t bytes_ = 0;            // 存储字节数
+  std::size_t align_ = 0;            // 存储对齐字节数
+  std::vector<std::size_t> offsets_; // 第 h 层(叶子为0)的起始位置
+};
+
+/**
+ * @brief 当前进程是否使用AVX2内核
+ */
+bool static_btree_uses_avx2();
+} // namespace SearchUtils
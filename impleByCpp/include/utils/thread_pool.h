@@ -0,0 +1,148 @@
+#pragma once
+// fork-join 线程池: parallel_for 把 [0, n) 个任务分给工作线程, 调用线程也参与执行
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ArrayUtils {
+// 并行算法的公共选项
+struct ParallelSortOptions {
+  std::size_t threads = 0;     // 最大并发度, 0 表示使用线程池全部线程
+  std::size_t grain = 1 << 16; // 单个任务处理的最少元素数
+};
+
+class ThreadPool {
+public:
+  /**
+   * @brief 构造线程池
+   *
+   * @param threads 总并发度(含调用线程), 0 表示使用硬件并发数
+   */
+  explicit ThreadPool(std::size_t threads = 0) {
+    if (threads == 0)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(threads - 1);
+    for (std::size_t i = 1; i < threads; ++i)
+      workers_.emplace_back([this, i] { worker_loop(i - 1); });
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_)
+      worker.join();
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // 总并发度(工作线程 + 调用线程)
+  std::size_t size() const { return workers_.size() + 1; }
+
+  /**
+   * @brief 并行执行 func(0) ... func(n - 1), 阻塞直到全部完成
+   * 任务内部再次调用 parallel_for 时退化为串行执行, 避免死锁; 任务不应抛出异常
+   *
+   * @tparam Func
+   * @param n 任务数
+   * @param func
+   * @param max_threads 最多参与执行的线程数(含调用线程), 0 表示不限
+   */
+  template <typename Func>
+  void parallel_for(std::size_t n, Func &&func, std::size_t max_threads = 0) {
+    if (n == 0)
+      return;
+    const std::size_t width =
+        std::min({n, size(), max_threads == 0 ? size() : max_threads});
+    if (width <= 1 || in_pool()) {
+      for (std::size_t i = 0; i < n; ++i)
+        func(i);
+      return;
+    }
+    std::lock_guard<std::mutex> submit(submit_mutex_);
+    std::function<void(std::size_t)> job(std::ref(func));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &job;
+      job_size_ = n;
+      next_.store(0, std::memory_order_relaxed);
+      job_workers_ = width - 1;
+      active_ = workers_.size();
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    in_pool() = true;
+    run_tasks(job, n);
+    in_pool() = false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    job_ = nullptr;
+  }
+
+  // 进程级共享线程池
+  static ThreadPool &instance() {
+    static ThreadPool pool;
+    return pool;
+  }
+
+private:
+  static bool &in_pool() {
+    static thread_local bool flag = false;
+    return flag;
+  }
+
+  void run_tasks(const std::function<void(std::size_t)> &job, std::size_t n) {
+    for (std::size_t i = next_.fetch_add(1, std::memory_order_relaxed); i < n;
+         i = next_.fetch_add(1, std::memory_order_relaxed))
+      job(i);
+  }
+
+  void worker_loop(std::size_t id) {
+    in_pool() = true;
+    std::uint64_t seen = 0;
+    while (true) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_)
+        return;
+      seen = generation_;
+      const auto *job = job_;
+      std::size_t n = job_size_;
+      // 只有编号靠前的工作线程参与, 受限的多次调用总落在同一组线程上
+      const bool participate = id < job_workers_;
+      lock.unlock();
+
+      if (participate)
+        run_tasks(*job, n);
+
+      lock.lock();
+      if (--active_ == 0)
+        done_.notify_all();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex submit_mutex_; // 串行化并发提交者
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(std::size_t)> *job_ = nullptr;
+  std::size_t job_size_ = 0;
+  std::atomic<std::size_t> next_{0};
+  std::size_t job_workers_ = 0;  // 本轮参与执行的工作线程数
+  std::size_t active_ = 0;       // 尚未完成本轮任务的工作线程数
+  std::uint64_t generation_ = 0; // 每次提交递增, 唤醒工作线程
+  bool stop_ = false;
+};
+} // namespace ArrayUtils
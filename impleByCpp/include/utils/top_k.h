@@ -0,0 +1,141 @@
+#pragma once
+// Top-K: 流式地保留按 comp 排序后的前k个元素(默认最小的k个; 取最大的k个用 std::greater<>)
+// 内部为大小不超过k的堆, 堆顶是当前保留元素中"最差"的一个, 新元素只需与堆顶比较一次
+// 并行版本: 每个线程维护自己的堆, 最后把各线程的堆合并
+#include "utils/introsort.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace ArrayUtils {
+template <typename T, typename Compare = std::less<>> class TopK {
+public:
+  /**
+   * @param k 保留的元素个数
+   * @param comp
+   */
+  explicit TopK(std::size_t k, Compare comp = Compare{})
+      : k_(k), comp_(std::move(comp)) {
+    heap_.reserve(k);
+  }
+
+  /**
+   * @brief 加入一个元素; 已满时只有比堆顶更靠前的元素才会替换堆顶
+   */
+  void push(const T &value) {
+    if (heap_.size() < k_) {
+      heap_.push_back(value);
+      if (heap_.size() == k_)
+        heapify(); // 攒满k个后一次性建堆, O(k)
+      return;
+    }
+    if (k_ != 0 && comp_(value, heap_.front())) {
+      heap_.front() = value;
+      detail::sift_down(heap_.begin(), static_cast<std::ptrdiff_t>(k_), 0,
+                        comp_);
+    }
+  }
+
+  template <typename InputIt> void push(InputIt first, InputIt last) {
+    for (; first != last; ++first)
+      push(*first);
+  }
+
+  /**
+   * @brief 并入另一个 TopK 保留的元素
+   */
+  void merge(const TopK &other) { push(other.heap_.begin(), other.heap_.end()); }
+
+  // 当前保留的元素个数
+  std::size_t size() const { return heap_.size(); }
+
+  /**
+   * @brief 已满时为第k个元素(保留元素中最靠后的一个), 可用作剪枝阈值
+   */
+  const T &threshold() const { return heap_.front(); }
+
+  /**
+   * @brief 按 comp 有序的保留元素
+   */
+  std::vector<T> sorted() const {
+    std::vector<T> result(heap_);
+    introsort(result.begin(), result.end(), comp_);
+    return result;
+  }
+
+private:
+  void heapify() {
+    const auto n = static_cast<std::ptrdiff_t>(heap_.size());
+    for (std::ptrdiff_t i = n / 2 - 1; i >= 0; --i)
+      detail::sift_down(heap_.begin(), n, i, comp_);
+  }
+
+  std::size_t k_;
+  std::vector<T> heap_; // 未满时无序, 满后为按 comp 的大顶堆
+  Compare comp_;
+};
+
+/**
+ * @brief 前k个元素(按 comp 有序), 不修改输入
+ *
+ * @tparam InputIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param k
+ * @param comp
+ * @return std::vector<T>
+ */
+template <typename InputIt, typename Compare = std::less<>>
+auto top_k(InputIt first, InputIt last, std::size_t k,
+           Compare comp = Compare{}) {
+  using T = typename std::iterator_traits<InputIt>::value_type;
+  TopK<T, Compare> heap(k, comp);
+  heap.push(first, last);
+  return heap.sorted();
+}
+
+/**
+ * @brief 并行 top-k: 按块切分, 每块独立维护大小为k的堆, 最后合并
+ *
+ * @tparam RandomIt
+ * @tparam Compare
+ * @param first
+ * @param last
+ * @param k
+ * @param comp
+ * @param options 并发度与任务粒度
+ * @param pool 执行所用线程池
+ * @return std::vector<T>
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+auto parallel_top_k(RandomIt first, RandomIt last, std::size_t k,
+                    Compare comp = Compare{},
+                    const ParallelSortOptions &options = {},
+                    ThreadPool &pool = ThreadPool::instance()) {
+  using T = typename std::iterator_traits<RandomIt>::value_type;
+  const auto n = static_cast<std::size_t>(last - first);
+  std::size_t threads = options.threads == 0
+                            ? pool.size()
+                            : std::min(options.threads, pool.size());
+  const std::size_t grain = std::max<std::size_t>(options.grain, 1);
+  const std::size_t blocks =
+      std::max<std::size_t>(std::min(threads, n / grain), 1);
+  if (blocks == 1)
+    return top_k(first, last, k, comp);
+
+  std::vector<TopK<T, Compare>> heaps(blocks, TopK<T, Compare>(k, comp));
+  pool.parallel_for(blocks, [&](std::size_t t) {
+    auto lo = static_cast<std::ptrdiff_t>(n * t / blocks);
+    auto hi = static_cast<std::ptrdiff_t>(n * (t + 1) / blocks);
+    heaps[t].push(first + lo, first + hi);
+  });
+  for (std::size_t t = 1; t < blocks; ++t)
+    heaps[0].merge(heaps[t]);
+  return heaps[0].sorted();
+}
+} // namespace ArrayUtils
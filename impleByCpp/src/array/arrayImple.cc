@@ -12,42 +12,30 @@
 namespace ArrayUtils {
 
 /**
- * @brief 基数排序
+ * @brief 基数排序, 按字节(8 bit)做LSD, 支持负数
  *
  * @param list
  */
 void radix_sort(std::vector<int> &list) {
-  if (list.empty())
-    return;
-
-  std::for_each(list.begin(), list.end(), [](int &x) {
-    if (x < 0) {
-      std::cout << "Radix sort does not support negative numbers.\n";
-      return;
-    }
-  });
-
-  int max = *std::max_element(list.begin(), list.end());
-  for (int exp = 1; max / exp > 0; exp *= 10) {
-    std::vector<int> count(10, 0);
-    std::vector<int> output(list.size());
-
-    for (int i = 0; i < list.size(); ++i)
-      count[(list[i] / exp) % 10]++;
-
-    for (int i = 1; i < 10; ++i)
-      count[i] += count[i - 1];
-
-    for (int i = list.size() - 1; i >= 0; --i) {
-      int idx = (list[i] / exp) % 10;
-      output[--count[idx]] = list[i];
-    }
+  radix_sort<8>(list.begin(), list.end());
+}
 
-    for (int i = 0; i < list.size(); ++i)
-      list[i] = output[i];
-  }
+/**
+ * @brief 桶排序, 两级计数分桶(粗桶适配L2, 细桶交给排序网络), 适合均匀分布的键
+ *
+ * @param list
+ */
+void bucket_sort(std::vector<int> &list) {
+  bucket_sort(list.begin(), list.end());
+}
 
-  std::cout << "radix_sort result:\n";
+/**
+ * @brief 计数排序, 值域由一次向量化 min/max 遍历自动确定, 值域远大于 n 时改用基数排序
+ *
+ * @param list
+ */
+void count_sort(std::vector<int> &list) {
+  counting_sort(list.begin(), list.end());
 }
 
 /**
@@ -67,36 +55,19 @@ void count_sort(std::vector<int> &arr, const int &min_val, const int &max_val) {
     throw std::invalid_argument("min_val cannot be greater than max_val");
   }
 
-  size_t n = arr.size();
-  int range = max_val - min_val + 1;
-
-  // 创建计数数组，初始化为0
-  std::vector<int> count(range, 0);
-
-  // 统计每个元素出现的次数
-  for (size_t i = 0; i < n; i++) {
-    if (arr[i] < min_val || arr[i] > max_val) {
-      throw std::out_of_range("Element out of specified range");
-    }
-    count[arr[i] - min_val]++;
-  }
-
-  // 计算累积计数（确定元素的位置）
-  for (int i = 1; i < range; i++) {
-    count[i] += count[i - 1];
+  // 先整体检查再写入, 越界时 arr 保持原样
+  auto [lo, hi] = simd_minmax(arr.data(), arr.size());
+  if (lo < min_val || hi > max_val) {
+    throw std::out_of_range("Element out of specified range");
   }
 
-  // 创建输出数组
-  std::vector<int> output(n);
-
-  // 从后往前遍历，保证稳定性
-  for (int i = n - 1; i >= 0; i--) {
-    output[count[arr[i] - min_val] - 1] = arr[i];
-    count[arr[i] - min_val]--;
+  // 统计每个元素出现的次数; 元素即键, 按计数原地回填即可, 无需输出数组
+  auto range = static_cast<std::size_t>(static_cast<long long>(hi) - lo) + 1;
+  std::vector<std::size_t> count(range, 0);
+  for (int x : arr) {
+    count[static_cast<std::size_t>(static_cast<long long>(x) - lo)]++;
   }
-
-  // 将排序结果复制回原数组
-  arr = output;
+  detail::fill_from_histogram(arr.data(), arr.size(), lo, count, 1);
 }
 
 /**
@@ -108,7 +79,6 @@ void shell_sort(std::vector<int> &list) {
   if (list.empty())
     return;
 
-  std::cout << "shell_sort result:\n";
   for (int gap = list.size() / 2; gap > 0; gap /= 2) {
     for (int i = gap; i < list.size(); ++i) {
       int temp = list[i];
@@ -123,47 +93,63 @@ void shell_sort(std::vector<int> &list) {
 }
 
 /**
- * @brief 多路合并
+ * @brief 合并相邻有序段 [left, mid] 与 [mid + 1, right], 使用调用方缓冲区, 不分配内存
+ * 左段移入 buf 后原地归并, buf 至少容纳 mid - left + 1 个元素
  *
  * @param list
  * @param left
  * @param mid
  * @param right
+ * @param buf
  */
 void merge(std::vector<int> &list, const int &left, const int &mid,
-           const int &right) {
-  int i = left, j = mid + 1;
-  std::vector<int> temp;
-
-  while (i <= mid && j <= right) {
-    if (list[i] <= list[j])
-      temp.push_back(list[i++]);
-    else
-      temp.push_back(list[j++]);
-  }
-  while (i <= mid)
-    temp.push_back(list[i++]);
-  while (j <= right)
-    temp.push_back(list[j++]);
+           const int &right, std::span<int> buf) {
+  if (left > mid || mid >= right)
+    return;
+  if (buf.size() < static_cast<std::size_t>(mid - left + 1))
+    throw std::invalid_argument("merge buffer is smaller than the left run");
+  std::less<> comp;
+  int *first = list.data() + left;
+  int *a_end = std::move(first, list.data() + mid + 1, buf.data());
+  detail::merge_move(buf.data(), a_end, list.data() + mid + 1,
+                     list.data() + right + 1, first, comp);
+}
 
-  for (int k = 0; k < temp.size(); ++k)
-    list[left + k] = temp[k];
+/**
+ * @brief 合并相邻有序段 [left, mid] 与 [mid + 1, right]
+ * 每次调用分配一块左段大小的临时缓冲区, 反复合并时应使用带缓冲区的版本
+ *
+ * @param list
+ * @param left
+ * @param mid
+ * @param right
+ */
+void merge(std::vector<int> &list, const int &left, const int &mid,
+           const int &right) {
+  if (left > mid || mid >= right)
+    return;
+  std::vector<int> buf(mid - left + 1);
+  merge(list, left, mid, right, buf);
 }
 
 /**
- * @brief 归并排序
+ * @brief 归并排序(稳定), 每次调用只分配一次 (n + 1) / 2 个元素的缓冲区, 返回时释放
  *
  * @param list
  * @param left
  * @param right
  */
 void merge_sort(std::vector<int> &list, const int &left, const int &right) {
-  if (left < right) {
-    int mid = left + (right - left) / 2;
-    merge_sort(list, left, mid);
-    merge_sort(list, mid + 1, right);
-    merge(list, left, mid, right);
+  if (left < 0 || left >= right)
+    return;
+  const auto n = static_cast<std::size_t>(right - left + 1);
+  auto first = list.begin() + left;
+  // 小区间交给排序网络, 不分配缓冲区
+  if (n <= kSmallSortMax) {
+    small_sort(list.data() + left, n);
+    return;
   }
+  stable_merge_sort(first, first + n, (n + 1) / 2);
 }
 
 /**
@@ -175,7 +161,6 @@ void bubble_sort(std::vector<int> &list) {
   if (list.empty())
     return;
 
-  std::cout << "bubble_sort result: ";
   for (int i = 0; i < list.size() - 1; ++i) {
     for (int j = 0; j < list.size() - i - 1; ++j) {
       if (list[j] > list[j + 1])
@@ -193,7 +178,6 @@ void opt_bubble_sort(std::vector<int> &list) {
   if (list.empty())
     return;
 
-  std::cout << "Optimized bubble_sort result:\n";
   for (int i = 0; i < list.size() - 1; ++i) {
     bool swapped = false;
     for (int j = 0; j < list.size() - i - 1; ++j) {
@@ -216,7 +200,6 @@ void selection_sort(std::vector<int> &list) {
   if (list.empty())
     return;
 
-  std::cout << "selection_sort result: ";
   for (int i = 0; i < list.size() - 1; ++i) {
     int minIndex = i;
     for (int j = i + 1; j < list.size(); ++j)
@@ -228,44 +211,39 @@ void selection_sort(std::vector<int> &list) {
 }
 
 /**
- * @brief 按pivot分区操作
+ * @brief 按pivot(list[high])分区操作, 扫描使用无分支块分区
  *
  * @param list
  * @param low
  * @param high
- * @return int
+ * @return int pivot最终位置, 其左侧均小于pivot, 右侧均不小于pivot
  */
 int partition(std::vector<int> &list, const int &low, const int &high) {
   if (list.empty() || low < 0 || high >= list.size() || low >= high)
     return -(1 << 10);
 
-  int pivot = list[high];
-  int i = low - 1;
-  for (int j = low; j < high; ++j) {
-    if (list[j] < pivot) {
-      ++i;
-      std::swap(list[i], list[j]);
-    }
-  }
-  std::swap(list[i + 1], list[high]);
-  return i + 1;
+  const int pivot = list[high];
+  auto mid = block_partition(list.begin() + low, list.begin() + high,
+                             [pivot](int x) { return x < pivot; });
+  std::iter_swap(mid, list.begin() + high);
+  return static_cast<int>(mid - list.begin());
 }
 
 /**
- * @brief 快速排序
+ * @brief 快速排序, 委托给内省排序(introsort), 有序/对抗输入下仍为 O(nlogn)
+ * 默认使用向量化分区(不支持AVX2时自动退化为标量实现)
  *
  * @param list
  * @param low
  * @param high
+ * @param scheme 分区策略
  */
-void quick_sort(std::vector<int> &list, const int &low, const int &high) {
+void quick_sort(std::vector<int> &list, const int &low, const int &high,
+                PartitionScheme scheme) {
   if (list.empty() || low < 0 || high >= list.size() || low >= high)
     return;
-  if (low < high) {
-    int partitionIndex = partition(list, low, high);
-    quick_sort(list, low, partitionIndex - 1);
-    quick_sort(list, partitionIndex + 1, high);
-  }
+  introsort(list.begin() + low, list.begin() + high + 1, std::less<>(),
+            scheme);
 }
 
 /**
@@ -277,7 +255,6 @@ void insertion_sort(std::vector<int> &list) {
   if (list.empty())
     return;
 
-  std::cout << "insertion_sort result:\n";
   for (int i = 1; i < list.size(); ++i) {
     int key = list[i];
     int j = i - 1;
@@ -290,42 +267,24 @@ void insertion_sort(std::vector<int> &list) {
 }
 
 /**
- * @brief 构建最大堆/大顶堆
+ * @brief 构建最大堆/大顶堆: 以 i 为根迭代下沉
  *
  * @param list
  * @param n
  * @param i
  */
 void heapify(std::vector<int> &list, const int &n, const int &i) {
-  int largest = i;
-  int left = 2 * i + 1;
-  int right = 2 * i + 2;
-
-  if (left < n && list[left] > list[largest])
-    largest = left;
-  if (right < n && list[right] > list[largest])
-    largest = right;
-  if (largest != i) {
-    std::swap(list[i], list[largest]);
-    heapify(list, n, largest);
-  }
+  std::less<> comp;
+  detail::sift_down(list.begin(), n, i, comp);
 }
 
 /**
- * @brief 堆排序
+ * @brief 堆排序, 4叉堆 + 自底向上下沉
  *
  * @param list list
  */
 void heap_sort(std::vector<int> &list) {
-  if (list.empty())
-    return;
-
-  for (int i = list.size() / 2 - 1; i >= 0; --i)
-    heapify(list, list.size(), i);
-  for (int i = list.size() - 1; i > 0; --i) {
-    std::swap(list[0], list[i]);
-    heapify(list, i, 0);
-  }
+  heap_sort<4>(list.begin(), list.end());
 }
 
 /**
@@ -0,0 +1,496 @@
+#include "utils/simd_sort.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ARRAY_UTILS_X86 1
+#include <immintrin.h>
+#endif
+
+// 双调排序网络: 先把每8个元素在寄存器内排好, 再逐级做双调归并(8->16->32->64)
+// 不足的部分用最大值填充, 保证填充元素排在末尾
+// 向量化分区: 先取出首尾各一个向量腾出空间, 每次从空闲空间较少的一端读入8个元素,
+// 按比较掩码查表置换后整向量写到左右两端, 左右写指针分别前进 左/右 元素个数
+namespace ArrayUtils {
+namespace {
+template <typename T> constexpr T pad_value() {
+  if constexpr (std::numeric_limits<T>::has_infinity)
+    return std::numeric_limits<T>::infinity();
+  else
+    return std::numeric_limits<T>::max();
+}
+
+/**
+ * @brief 标量双调排序网络, min/max 编译为条件传送, 不依赖分支预测
+ */
+template <typename T> void scalar_bitonic_sort(T *data, std::size_t n) {
+  T buf[kSmallSortMax];
+  const std::size_t size = std::bit_ceil(n);
+  std::copy(data, data + n, buf);
+  std::fill(buf + n, buf + size, pad_value<T>());
+  for (std::size_t k = 2; k <= size; k *= 2) {
+    for (std::size_t j = k / 2; j > 0; j /= 2) {
+      for (std::size_t i = 0; i < size; ++i) {
+        std::size_t l = i ^ j;
+        if (l <= i)
+          continue;
+        T lo = std::min(buf[i], buf[l]);
+        T hi = std::max(buf[i], buf[l]);
+        bool descending = (i & k) != 0;
+        buf[i] = descending ? hi : lo;
+        buf[l] = descending ? lo : hi;
+      }
+    }
+  }
+  std::copy(buf, buf + n, data);
+}
+
+/**
+ * @brief 无分支的标量分区(Lomuto): 每步都交换, 仅按比较结果推进左边界
+ */
+template <typename T>
+std::size_t scalar_partition(T *data, std::size_t n, T pivot,
+                             bool inclusive) {
+  std::size_t i = 0;
+  for (std::size_t j = 0; j < n; ++j) {
+    T x = data[j];
+    bool left = inclusive ? !(pivot < x) : x < pivot;
+    data[j] = data[i];
+    data[i] = x;
+    i += left;
+  }
+  return i;
+}
+
+/**
+ * @brief 标量 min/max, 用作回退与尾部处理
+ */
+std::pair<int, int> scalar_minmax(const int *data, std::size_t n) {
+  int lo = data[0], hi = data[0];
+  for (std::size_t i = 1; i < n; ++i) {
+    lo = std::min(lo, data[i]);
+    hi = std::max(hi, data[i]);
+  }
+  return {lo, hi};
+}
+
+// 分区查表: 掩码第x位为1表示通道x属于右侧, 置换后左侧元素在前、右侧元素在后
+struct PartitionTable {
+  std::uint8_t index[256][8];
+};
+
+constexpr PartitionTable make_partition_table() {
+  PartitionTable table{};
+  for (int mask = 0; mask < 256; ++mask) {
+    int k = 0;
+    for (int x = 0; x < 8; ++x)
+      if (!(mask & (1 << x)))
+        table.index[mask][k++] = static_cast<std::uint8_t>(x);
+    for (int x = 0; x < 8; ++x)
+      if (mask & (1 << x))
+        table.index[mask][k++] = static_cast<std::uint8_t>(x);
+  }
+  return table;
+}
+
+alignas(64) constexpr PartitionTable kPartitionTable = make_partition_table();
+
+#if ARRAY_UTILS_X86
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))),                \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+struct Avx2Int {
+  using T = int;
+  using V = __m256i;
+  static V load(const T *p) {
+    return _mm256_load_si256(reinterpret_cast<const V *>(p));
+  }
+  static void store(T *p, V v) {
+    _mm256_store_si256(reinterpret_cast<V *>(p), v);
+  }
+  static V min(V a, V b) { return _mm256_min_epi32(a, b); }
+  static V max(V a, V b) { return _mm256_max_epi32(a, b); }
+  static V permute(V v, __m256i idx) {
+    return _mm256_permutevar8x32_epi32(v, idx);
+  }
+  template <int Mask> static V blend(V a, V b) {
+    return _mm256_blend_epi32(a, b, Mask);
+  }
+  static V set1(T x) { return _mm256_set1_epi32(x); }
+  static V loadu(const T *p) {
+    return _mm256_loadu_si256(reinterpret_cast<const V *>(p));
+  }
+  static void storeu(T *p, V v) {
+    _mm256_storeu_si256(reinterpret_cast<V *>(p), v);
+  }
+  // 属于右侧的通道掩码
+  static int right_mask(V v, V pivot, bool inclusive) {
+    if (inclusive)
+      return _mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpgt_epi32(v, pivot)));
+    return ~_mm256_movemask_ps(
+               _mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v))) &
+           0xFF;
+  }
+};
+
+struct Avx2Float {
+  using T = float;
+  using V = __m256;
+  static V load(const T *p) { return _mm256_load_ps(p); }
+  static void store(T *p, V v) { _mm256_store_ps(p, v); }
+  static V min(V a, V b) { return _mm256_min_ps(a, b); }
+  static V max(V a, V b) { return _mm256_max_ps(a, b); }
+  static V permute(V v, __m256i idx) {
+    return _mm256_permutevar8x32_ps(v, idx);
+  }
+  template <int Mask> static V blend(V a, V b) {
+    return _mm256_blend_ps(a, b, Mask);
+  }
+  static V set1(T x) { return _mm256_set1_ps(x); }
+  static V loadu(const T *p) { return _mm256_loadu_ps(p); }
+  static void storeu(T *p, V v) { _mm256_storeu_ps(p, v); }
+  static int right_mask(V v, V pivot, bool inclusive) {
+    if (inclusive)
+      return _mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_GT_OQ));
+    return _mm256_movemask_ps(_mm256_cmp_ps(v, pivot, _CMP_GE_OQ));
+  }
+};
+
+// 第x个通道在 (k, j) 这一级取较大值的掩码
+constexpr int max_mask(int k, int j) {
+  int mask = 0;
+  for (int x = 0; x < 8; ++x)
+    if (((x & j) != 0) != ((x & k) != 0))
+      mask |= 1 << x;
+  return mask;
+}
+
+template <int J> __m256i partner() {
+  return _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J,
+                           7 ^ J);
+}
+
+// 寄存器内一级比较交换: 与通道 x^J 比较, Mask 为1的通道取较大值
+template <typename Ops, int J, int Mask>
+typename Ops::V stage(typename Ops::V v) {
+  auto p = Ops::permute(v, partner<J>());
+  return Ops::template blend<Mask>(Ops::min(v, p), Ops::max(v, p));
+}
+
+// 寄存器内8元素双调排序(6级)
+template <typename Ops> typename Ops::V sort8(typename Ops::V v) {
+  v = stage<Ops, 1, max_mask(2, 1)>(v);
+  v = stage<Ops, 2, max_mask(4, 2)>(v);
+  v = stage<Ops, 1, max_mask(4, 1)>(v);
+  v = stage<Ops, 4, max_mask(8, 4)>(v);
+  v = stage<Ops, 2, max_mask(8, 2)>(v);
+  return stage<Ops, 1, max_mask(8, 1)>(v);
+}
+
+// 寄存器内双调序列升序归并(3级)
+template <typename Ops> typename Ops::V merge8(typename Ops::V v) {
+  v = stage<Ops, 4, max_mask(8, 4)>(v);
+  v = stage<Ops, 2, max_mask(8, 2)>(v);
+  return stage<Ops, 1, max_mask(8, 1)>(v);
+}
+
+template <typename Ops> typename Ops::V reverse8(typename Ops::V v) {
+  return Ops::permute(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+/**
+ * @brief Count 个寄存器(Count*8 个元素)的双调排序
+ */
+template <typename Ops, int Count> void bitonic_network(typename Ops::T *buf) {
+  typename Ops::V v[Count];
+  for (int i = 0; i < Count; ++i)
+    v[i] = sort8<Ops>(Ops::load(buf + 8 * i));
+  for (int w = 1; w < Count; w *= 2) {
+    for (int g = 0; g < Count; g += 2 * w) {
+      // 反转后一段, 使两段升序序列拼成双调序列
+      for (int i = 0; i < w / 2; ++i) {
+        auto tmp = v[g + w + i];
+        v[g + w + i] = v[g + 2 * w - 1 - i];
+        v[g + 2 * w - 1 - i] = tmp;
+      }
+      for (int i = 0; i < w; ++i)
+        v[g + w + i] = reverse8<Ops>(v[g + w + i]);
+      // 跨寄存器的半清理器
+      for (int d = w; d >= 1; d /= 2) {
+        for (int i = g; i < g + 2 * w; ++i) {
+          if (((i - g) & d) != 0)
+            continue;
+          auto lo = Ops::min(v[i], v[i + d]);
+          auto hi = Ops::max(v[i], v[i + d]);
+          v[i] = lo;
+          v[i + d] = hi;
+        }
+      }
+      for (int i = g; i < g + 2 * w; ++i)
+        v[i] = merge8<Ops>(v[i]);
+    }
+  }
+  for (int i = 0; i < Count; ++i)
+    Ops::store(buf + 8 * i, v[i]);
+}
+
+template <typename Ops> void avx2_small_sort(typename Ops::T *data,
+                                             std::size_t n) {
+  using T = typename Ops::T;
+  alignas(32) T buf[kSmallSortMax];
+  const std::size_t vectors = std::bit_ceil((n + 7) / 8);
+  std::copy(data, data + n, buf);
+  std::fill(buf + n, buf + vectors * 8, pad_value<T>());
+  switch (vectors) {
+  case 1:
+    bitonic_network<Ops, 1>(buf);
+    break;
+  case 2:
+    bitonic_network<Ops, 2>(buf);
+    break;
+  case 4:
+    bitonic_network<Ops, 4>(buf);
+    break;
+  default:
+    bitonic_network<Ops, 8>(buf);
+    break;
+  }
+  std::copy(buf, buf + n, data);
+}
+
+// 把一个向量分区后整向量写到左右两端(写出的多余通道落在空闲区内)
+template <typename Ops>
+void partition_vector(typename Ops::T *data, typename Ops::V v,
+                      typename Ops::V pivot, bool inclusive,
+                      std::size_t &write_l, std::size_t &write_r) {
+  int mask = Ops::right_mask(v, pivot, inclusive);
+  __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+      reinterpret_cast<const __m128i *>(kPartitionTable.index[mask])));
+  auto perm = Ops::permute(v, idx);
+  Ops::storeu(data + write_l, perm);
+  Ops::storeu(data + write_r - 8, perm);
+  int right = std::popcount(static_cast<unsigned>(mask));
+  write_l += 8 - right;
+  write_r -= right;
+}
+
+template <typename Ops>
+std::size_t avx2_partition(typename Ops::T *data, std::size_t n,
+                           typename Ops::T pivot, bool inclusive) {
+  using T = typename Ops::T;
+  if (n < 16)
+    return scalar_partition(data, n, pivot, inclusive);
+  const auto p = Ops::set1(pivot);
+  // 首尾向量先取出, 保证两端各有至少8个空闲位置
+  const auto head = Ops::loadu(data);
+  const auto tail = Ops::loadu(data + n - 8);
+  std::size_t read_l = 8, read_r = n - 8;
+  std::size_t write_l = 0, write_r = n;
+  while (read_r - read_l >= 8) {
+    typename Ops::V v;
+    if (read_l - write_l <= write_r - read_r) {
+      v = Ops::loadu(data + read_l);
+      read_l += 8;
+    } else {
+      read_r -= 8;
+      v = Ops::loadu(data + read_r);
+    }
+    partition_vector<Ops>(data, v, p, inclusive, write_l, write_r);
+  }
+  // 剩余不足8个元素与首尾向量逐个写入, 此时 [write_l, write_r) 恰好容纳它们
+  T rest[24];
+  std::size_t r = read_r - read_l;
+  std::copy(data + read_l, data + read_r, rest);
+  Ops::storeu(rest + r, head);
+  Ops::storeu(rest + r + 8, tail);
+  for (std::size_t i = 0; i < r + 16; ++i) {
+    T x = rest[i];
+    bool left = inclusive ? !(pivot < x) : x < pivot;
+    if (left)
+      data[write_l++] = x;
+    else
+      data[--write_r] = x;
+  }
+  return write_l;
+}
+
+void avx2_small_sort_int(int *data, std::size_t n) {
+  avx2_small_sort<Avx2Int>(data, n);
+}
+
+void avx2_small_sort_float(float *data, std::size_t n) {
+  avx2_small_sort<Avx2Float>(data, n);
+}
+
+std::size_t avx2_partition_int(int *data, std::size_t n, int pivot,
+                               bool inclusive) {
+  return avx2_partition<Avx2Int>(data, n, pivot, inclusive);
+}
+
+std::size_t avx2_partition_float(float *data, std::size_t n, float pivot,
+                                 bool inclusive) {
+  return avx2_partition<Avx2Float>(data, n, pivot, inclusive);
+}
+
+// 4组累加寄存器, 每轮处理32个元素, 隐藏 min/max 指令的延迟
+std::pair<int, int> avx2_minmax(const int *data, std::size_t n) {
+  if (n < 32)
+    return scalar_minmax(data, n);
+  __m256i lo[4], hi[4];
+  for (int k = 0; k < 4; ++k)
+    lo[k] = hi[k] = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(data + 8 * k));
+  std::size_t i = 32;
+  for (; i + 32 <= n; i += 32) {
+    for (int k = 0; k < 4; ++k) {
+      __m256i v = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(data + i + 8 * k));
+      lo[k] = _mm256_min_epi32(lo[k], v);
+      hi[k] = _mm256_max_epi32(hi[k], v);
+    }
+  }
+  __m256i l = _mm256_min_epi32(_mm256_min_epi32(lo[0], lo[1]),
+                               _mm256_min_epi32(lo[2], lo[3]));
+  __m256i h = _mm256_max_epi32(_mm256_max_epi32(hi[0], hi[1]),
+                               _mm256_max_epi32(hi[2], hi[3]));
+  alignas(32) int lanes_lo[8], lanes_hi[8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes_lo), l);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes_hi), h);
+  int min_v = *std::min_element(lanes_lo, lanes_lo + 8);
+  int max_v = *std::max_element(lanes_hi, lanes_hi + 8);
+  for (; i < n; ++i) {
+    min_v = std::min(min_v, data[i]);
+    max_v = std::max(max_v, data[i]);
+  }
+  return {min_v, max_v};
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif // ARRAY_UTILS_X86
+
+bool detect_avx2() {
+#if ARRAY_UTILS_X86
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+template <typename T> using Kernel = void (*)(T *, std::size_t);
+
+template <typename T> Kernel<T> resolve_kernel() {
+#if ARRAY_UTILS_X86
+  if (detect_avx2()) {
+    if constexpr (std::is_same_v<T, int>)
+      return avx2_small_sort_int;
+    else
+      return avx2_small_sort_float;
+  }
+#endif
+  return scalar_bitonic_sort<T>;
+}
+
+template <typename T>
+using PartitionKernel = std::size_t (*)(T *, std::size_t, T, bool);
+
+template <typename T> PartitionKernel<T> resolve_partition_kernel() {
+#if ARRAY_UTILS_X86
+  if (detect_avx2()) {
+    if constexpr (std::is_same_v<T, int>)
+      return avx2_partition_int;
+    else
+      return avx2_partition_float;
+  }
+#endif
+  return scalar_partition<T>;
+}
+
+using MinMaxKernel = std::pair<int, int> (*)(const int *, std::size_t);
+
+MinMaxKernel resolve_minmax_kernel() {
+#if ARRAY_UTILS_X86
+  if (detect_avx2())
+    return avx2_minmax;
+#endif
+  return scalar_minmax;
+}
+
+template <typename T>
+std::size_t dispatch_partition(T *data, std::size_t n, T pivot,
+                               bool inclusive) {
+  static const PartitionKernel<T> kernel = resolve_partition_kernel<T>();
+  return kernel(data, n, pivot, inclusive);
+}
+
+template <typename T> void dispatch_small_sort(T *data, std::size_t n) {
+  static const Kernel<T> kernel = resolve_kernel<T>();
+  if (n < 2)
+    return;
+  if (n > kSmallSortMax)
+    throw std::invalid_argument("small_sort supports at most 64 elements");
+  kernel(data, n);
+}
+} // namespace
+
+void small_sort(int *data, std::size_t n) { dispatch_small_sort(data, n); }
+
+void small_sort(float *data, std::size_t n) { dispatch_small_sort(data, n); }
+
+std::size_t simd_partition(int *data, std::size_t n, int pivot,
+                           bool inclusive) {
+  return dispatch_partition(data, n, pivot, inclusive);
+}
+
+std::size_t simd_partition(float *data, std::size_t n, float pivot,
+                           bool inclusive) {
+  return dispatch_partition(data, n, pivot, inclusive);
+}
+
+std::pair<int, int> simd_minmax(const int *data, std::size_t n) {
+  static const MinMaxKernel kernel = resolve_minmax_kernel();
+  return kernel(data, n);
+}
+
+bool simd_sort_uses_avx2() { return detect_avx2(); }
+
+namespace detail {
+void small_sort_scalar(int *data, std::size_t n) {
+  if (n >= 2 && n <= kSmallSortMax)
+    scalar_bitonic_sort(data, n);
+}
+
+void small_sort_scalar(float *data, std::size_t n) {
+  if (n >= 2 && n <= kSmallSortMax)
+    scalar_bitonic_sort(data, n);
+}
+
+std::size_t simd_partition_scalar(int *data, std::size_t n, int pivot,
+                                  bool inclusive) {
+  return scalar_partition(data, n, pivot, inclusive);
+}
+
+std::size_t simd_partition_scalar(float *data, std::size_t n, float pivot,
+                                  bool inclusive) {
+  return scalar_partition(data, n, pivot, inclusive);
+}
+
+std::pair<int, int> simd_minmax_scalar(const int *data, std::size_t n) {
+  return scalar_minmax(data, n);
+}
+} // namespace detail
+} // namespace ArrayUtils
@@ -1,4 +1,5 @@
 #include "core_api/graph_utils.h"
+#include "utils/log.h"
 #include <algorithm>
 #include <cassert>
 #include <iostream>
@@ -36,8 +37,7 @@ Graph::~Graph() {
   }
   _vertexList.clear();
   _edgeList.clear();
-  std::cout << "Graph object implemented as a adjacency list is destroyed."
-            << std::endl;
+  log_utils::log("Graph object implemented as a adjacency list is destroyed.");
 }
 
 /**
@@ -50,11 +50,11 @@ bool Graph::initGraph(
     std::vector<VertexType> &vertexList,
     std::map<std::pair<VertexType, VertexType>, EdgeType> &edgeList) {
   if (vertexList.empty() || edgeList.empty()) {
-    std::cout << "empty input." << std::endl;
+    log_utils::log("empty input.");
     return false;
   }
   if (vertexList.size() != _numOfVertices || edgeList.size() != _numOfEdges) {
-    std::cout << "Invalid input." << std::endl;
+    log_utils::log("Invalid input.");
     return false;
   }
   for (int i = 0; i < _numOfVertices; i++) {
@@ -65,7 +65,7 @@ bool Graph::initGraph(
     initEdge(it->first.first, it->first.second, it->second);
   }
   // TODO:计算强连通分量
-  std::cout << "Graph initialized successfully." << std::endl;
+  log_utils::log("Graph initialized successfully.");
   return true;
 }
 
@@ -155,17 +155,17 @@ void Graph::initEdge(const VertexType &src, const VertexType &dest,
 bool Graph::addEdge(const VertexType &src, const VertexType &dest,
                     const EdgeType &weight) {
   if (!isVertex(src) || !isVertex(dest)) {
-    std::cout << "plz add vertex first." << std::endl;
+    log_utils::log("plz add vertex first.");
     return false; // ensure both vertices are in the graph
   }
   if (!isEdge(src, dest)) {
     initEdge(src, dest, weight);
     _numOfEdges++;
-    std::cout << "Edge (" << src << ", " << dest << "[" << weight
-              << "]) added to the graph." << std::endl;
+    log_utils::log("Edge (", src, ", ", dest, "[", weight,
+                   "]) added to the graph.");
   } else {
-    std::cout << "Edge (" << src << ", " << dest << "[" << weight
-              << "]) already in the graph." << std::endl;
+    log_utils::log("Edge (", src, ", ", dest, "[", weight,
+                   "]) already in the graph.");
   }
   return true;
 }
@@ -185,7 +185,7 @@ bool Graph::addVertex(const VertexType &vertex) {
   _vertexList[_numOfVertices]._vertex = vertex;
   _vertexList[_numOfVertices]._firstEdge = nullptr;
   _numOfVertices++;
-  std::cout << "Vertex " << vertex << " added to the graph." << std::endl;
+  log_utils::log("Vertex ", vertex, " added to the graph.");
   return true;
 }
 
@@ -228,7 +228,7 @@ bool Graph::deleteEdge(const VertexType &src, const VertexType &dest) {
  */
 bool Graph::deleteVertex(const VertexType &vertex) {
   if (!isVertex(vertex)) {
-    std::cout << "Vertex " << vertex << " not found!" << std::endl;
+    log_utils::log("Vertex ", vertex, " not found!");
     return false;
   }
 
@@ -277,7 +277,7 @@ bool Graph::deleteVertex(const VertexType &vertex) {
   _vertexList[pos]._firstEdge = nullptr;
   _vertexList.erase(_vertexList.begin() + pos);
   _numOfVertices--;
-  std::cout << "Vertex " << vertex << " deleted from the graph." << std::endl;
+  log_utils::log("Vertex ", vertex, " deleted from the graph.");
   return true;
 }
 
@@ -374,7 +374,8 @@ void Graph::printCycle(const std::vector<VertexType> &cycle) {
 }
 
 /**
- * @brief Check if the graph has any cycle. output all cycles found.
+ * @brief Check if the graph has any cycle. all cycles found are kept and
+ * can be fetched by getCycles().
  *
  * @return true if the graph has any cycle, false otherwise.
  */
@@ -396,32 +397,31 @@ bool Graph::is_cyclic() {
     }
   }
 
-  // output all cycles found
-  if (!cycles.empty()) {
-    std::cout << "Found " << cycles.size()
-              << " cycle(s) in the graph:" << std::endl;
-    for (size_t i = 0; i < cycles.size(); i++) {
-      std::cout << "Cycle " << i + 1 << ": ";
-      printCycle(cycles[i]);
-    }
-    return true;
-  } else {
-    std::cout << "No cycles found in the graph." << std::endl;
-    return false;
-  }
+  log_utils::log("Found ", cycles.size(), " cycle(s) in the graph.");
+  return !cycles.empty();
+}
+
+/**
+ * @brief Cycles found by the last call of is_cyclic().
+ *
+ * @return const std::vector<std::vector<VertexType>>& 每个环首尾顶点相同
+ */
+const std::vector<std::vector<VertexType>> &Graph::getCycles() const {
+  return cycles;
 }
 
 /**
  * @brief Deep-First Search (Iterative)
  *
  * @param startVertex
+ * @param visit 按访问顺序对每个顶点调用, 可为空
  * @return true
  * @return false
  */
-bool Graph::DFS(const VertexType &startVertex) {
+bool Graph::DFS(const VertexType &startVertex, const VertexVisitor &visit) {
   int startIdx = position(startVertex);
   if (startIdx == -1) {
-    std::cout << "Start vertex not found!" << std::endl;
+    log_utils::log("Start vertex not found!");
     return false;
   }
 
@@ -429,15 +429,14 @@ bool Graph::DFS(const VertexType &startVertex) {
   std::vector<bool> visited(_numOfVertices, false);
   std::stack<VertexType> stack;
 
-  std::cout << "DFS traversal (iterative): ";
-
   stack.push(startVertex);
   visited[startIdx] = true;
 
   while (!stack.empty()) {
     VertexType current = stack.top();
     stack.pop();
-    std::cout << current << " ";
+    if (visit)
+      visit(current);
 
     int currentIdx = position(current);
     if (currentIdx == -1)
@@ -464,7 +463,6 @@ bool Graph::DFS(const VertexType &startVertex) {
       }
     }
   }
-  std::cout << std::endl;
   return true;
 }
 
@@ -472,20 +470,20 @@ bool Graph::DFS(const VertexType &startVertex) {
  * @brief Deep-First Search (Recursive)
  *
  * @param startVertex
+ * @param visit 按访问顺序对每个顶点调用, 可为空
  * @return true
  * @return false
  */
-bool Graph::DFS_recursive(const VertexType &startVertex) {
+bool Graph::DFS_recursive(const VertexType &startVertex,
+                          const VertexVisitor &visit) {
   int startIdx = position(startVertex);
   if (startIdx == -1) {
-    std::cout << "Start vertex not found!" << std::endl;
+    log_utils::log("Start vertex not found!");
     return false;
   }
 
   std::vector<bool> visited(_numOfVertices, false);
-  std::cout << "DFS traversal (recursive): ";
-  DFS_recursive_util(startVertex, visited);
-  std::cout << std::endl;
+  DFS_recursive_util(startVertex, visited, visit);
   return true;
 }
 
@@ -494,21 +492,24 @@ bool Graph::DFS_recursive(const VertexType &startVertex) {
  *
  * @param current
  * @param visited
+ * @param visit 可为空
  */
 void Graph::DFS_recursive_util(const VertexType &current,
-                               std::vector<bool> &visited) {
+                               std::vector<bool> &visited,
+                               const VertexVisitor &visit) {
   int currentIdx = position(current);
   if (currentIdx == -1 || visited[currentIdx]) {
     return;
   }
 
   visited[currentIdx] = true;
-  // std::cout << current << " ";
+  if (visit)
+    visit(current);
 
   // 递归访问所有邻居
   AdjListNode *neighbor = _vertexList[currentIdx]._firstEdge;
   while (neighbor != nullptr) {
-    DFS_recursive_util(neighbor->_vertex, visited);
+    DFS_recursive_util(neighbor->_vertex, visited, visit);
     neighbor = neighbor->_next;
   }
 }
@@ -517,11 +518,12 @@ void Graph::DFS_recursive_util(const VertexType &current,
  * @brief Width-First Search (Breadth-First Search)
  *
  * @param startVertex
+ * @param visit 按访问顺序对每个顶点调用, 可为空
  */
-bool Graph::BFS(const VertexType &startVertex) {
+bool Graph::BFS(const VertexType &startVertex, const VertexVisitor &visit) {
   int startIdx = position(startVertex);
   if (startIdx == -1) {
-    std::cout << "Start vertex not found!" << std::endl;
+    log_utils::log("Start vertex not found!");
     return false;
   }
 
@@ -529,15 +531,14 @@ bool Graph::BFS(const VertexType &startVertex) {
   std::vector<bool> visited(_numOfVertices, false);
   std::queue<VertexType> queue;
 
-  std::cout << "BFS traversal: ";
-
   queue.push(startVertex);
   visited[startIdx] = true;
 
   while (!queue.empty()) {
     VertexType current = queue.front();
     queue.pop();
-    std::cout << current << " ";
+    if (visit)
+      visit(current);
 
     int currentIdx = position(current);
     if (currentIdx == -1)
@@ -554,7 +555,6 @@ bool Graph::BFS(const VertexType &startVertex) {
       neighbor = neighbor->_next;
     }
   }
-  std::cout << std::endl;
   return true;
 }
 
@@ -693,7 +693,12 @@ bool Graph::isCyclicDFS(const VertexType &current) {
   return hasCycle;
 }
 
-void Graph::topologicalSort() {
+/**
+ * @brief 拓扑排序(DFS 完成序的逆序)
+ *
+ * @return std::vector<VertexType> 拓扑序
+ */
+std::vector<VertexType> Graph::topologicalSort() {
   assert(!is_cyclic() && "Graph contains a cycle, topological sort not possible.");
   std::stack<VertexType> stack;
   visited.assign(_numOfVertices, false);
@@ -704,12 +709,13 @@ void Graph::topologicalSort() {
     }
   }
 
-  std::cout << "Topological Sort: ";
+  std::vector<VertexType> order;
+  order.reserve(stack.size());
   while (!stack.empty()) {
-    std::cout << stack.top() << " ";
+    order.push_back(stack.top());
     stack.pop();
   }
-  std::cout << std::endl;
+  return order;
 }
 
 /**
@@ -799,8 +805,7 @@ void Matrix::connectedComponent() {
 std::pair<std::vector<Edge>, int> Matrix::MinimumSpanningTreeKruskal() {
   assert(_connectedComponentNum == 1 &&
          "The graph must be connected for Kruskal's algorithm.");
-  std::cout << "Minimum Spanning Tree (MST) using Kruskal's algorithm:"
-            << std::endl;
+  log_utils::log("Minimum Spanning Tree (MST) using Kruskal's algorithm.");
   // 1. initialize edge weight set and sort it by weight
   auto cmp = [](const Edge &a, const Edge &b) { return a._weight < b._weight; };
   std::set<Edge, decltype(cmp)> edges;
@@ -872,7 +877,7 @@ Matrix::Matrix(bool isDirected, bool compacted, unsigned int numOfVertices,
  *
  */
 Matrix::~Matrix() {
-  std::cout << "Adjacency Matrix is destroyed." << std::endl;
+  log_utils::log("Adjacency Matrix is destroyed.");
   _vertexList.clear();
   _matrix.clear();
 }
@@ -882,14 +887,14 @@ void Matrix::initMatrix(
     std::map<std::pair<VertexType, VertexType>, EdgeType> &edgeList) {
   initVertex(vertexList);
   if (edgeList.size() != _numOfEdges) {
-    std::cout << "Wrong number of edges in the input." << std::endl;
+    log_utils::log("Wrong number of edges in the input.");
     return;
   }
   for (auto it = edgeList.begin(); it != edgeList.end(); it++) {
     initEdge(it->first.first, it->first.second, it->second);
   }
   _edgeList = edgeList;
-  std::cout << "Adjacency Matrix is initialized." << std::endl;
+  log_utils::log("Adjacency Matrix is initialized.");
 }
 
 void Matrix::initEdge(const VertexType &src, const VertexType &dest,
@@ -897,7 +902,7 @@ void Matrix::initEdge(const VertexType &src, const VertexType &dest,
   int srcIdx = position(src);
   int destIdx = position(dest);
   if (srcIdx == -1 || destIdx == -1) {
-    std::cout << "No such vertex in the graph." << std::endl;
+    log_utils::log("No such vertex in the graph.");
     return; // ensure both vertices are in the graph
   }
   if (_isDirected) {
@@ -918,7 +923,7 @@ void Matrix::initVertex(const std::vector<VertexType> &vertexList) {
     return;
   }
   if (vertexList.size() != _numOfVertices) {
-    std::cout << "Invalid input for initializing the graph." << std::endl;
+    log_utils::log("Invalid input for initializing the graph.");
     return;
   }
   _vertexList = vertexList;
@@ -1118,11 +1123,17 @@ void Matrix::deleteEdge(const VertexType &src, const VertexType &dest) {
   }
 }
 
-void Matrix::DFS(const VertexType &start) {
+/**
+ * @brief Deep-First Search (无向图)
+ *
+ * @param start
+ * @param visit 按访问顺序对每个顶点调用, 可为空
+ */
+void Matrix::DFS(const VertexType &start, const VertexVisitor &visit) {
   assert(!_isDirected && "Just for undirected graph");
   int startIdx = position(start);
   if (startIdx == -1) {
-    std::cout << "Vertex " << start << " is not in the graph." << std::endl;
+    log_utils::log("Vertex ", start, " is not in the graph.");
     return;
   }
 
@@ -1130,7 +1141,8 @@ void Matrix::DFS(const VertexType &start) {
   std::vector<bool> visited(_numOfVertices, false);
   stack.push(startIdx);
   visited[startIdx] = true;
-  std::cout << start << " -> ";
+  if (visit)
+    visit(start);
 
   while (!stack.empty()) {
     int currIdx = stack.top();
@@ -1139,12 +1151,12 @@ void Matrix::DFS(const VertexType &start) {
     for (int neighborIdx = 0; neighborIdx < _numOfVertices; neighborIdx++) {
       if (_matrix[currIdx][neighborIdx] != 0 && !visited[neighborIdx]) {
         visited[neighborIdx] = true;
-        std::cout << _vertexList[neighborIdx] << " -> ";
+        if (visit)
+          visit(_vertexList[neighborIdx]);
         stack.push(neighborIdx);
       }
     }
   }
-  std::cout << "null" << std::endl;
 }
 
 std::vector<VertexType> Matrix::getAdjacentVertices(const VertexType &vertex) {
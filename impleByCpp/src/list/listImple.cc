@@ -1,4 +1,5 @@
 #include "core_api/list_utils.h"
+#include "utils/log.h"
 #include <iostream>
 
 /**
@@ -79,7 +80,7 @@ void print_list(const LinkList &list) {
 LinkList &create_list_with_tailinsert(const std::vector<NodeVal> &vals) {
   LinkList *list = new LinkList();
   if (list == nullptr) {
-    std::cout << "memory allocation failure\n";
+    log_utils::log("memory allocation failure");
     throw std::bad_alloc();
   }
   for (auto val : vals) {
@@ -67,9 +67,14 @@ int main() {
       {{'A', 'B'}, 1}, {{'A', 'C'}, 3}, {{'B', 'C'}, 4}, {{'B', 'D'}, 2},
       {{'C', 'D'}, 9}, {{'B', 'E'}, 5}, {{'C', 'F'}, 7}, {{'E', 'F'}, 8}};
   graph2.initGraph(vertexList2, edgeList3);
-  graph2.DFS('A');
-  graph2.DFS_recursive('A');
-  graph2.BFS('A');
+  auto printVertex = [](const VertexType &v) { std::cout << v << " "; };
+  std::cout << "DFS traversal (iterative): ";
+  graph2.DFS('A', printVertex);
+  std::cout << std::endl << "DFS traversal (recursive): ";
+  graph2.DFS_recursive('A', printVertex);
+  std::cout << std::endl << "BFS traversal: ";
+  graph2.BFS('A', printVertex);
+  std::cout << std::endl;
   graph2.printGraph();
 
   graph2.addVertex('I');
@@ -103,7 +108,8 @@ int main() {
   std::cout << "Is edge (C, F) in the graph? " << matrix.isEdge('C', 'F')
             << std::endl;
   std::cout << "Deep-First-Search (DFS) started from vertex B: ";
-  matrix.DFS('B');
+  matrix.DFS('B', [](const VertexType &v) { std::cout << v << " -> "; });
+  std::cout << "null" << std::endl;
   matrix.connectedComponent();
   auto mstEdges_Kruskal = matrix.MinimumSpanningTreeKruskal();
   matrix.printMST(mstEdges_Kruskal);
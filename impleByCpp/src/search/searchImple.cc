@@ -1,14 +1,9 @@
 #include "core_api/search_utils.h"
+#include <cstdint>
 
 int linearSearch(const std::vector<int> &arr, const int &target) {
-  int index = -1;
-  for (int i = 0; i < arr.size(); i++) {
-    if (arr[i] == target) {
-      index = i;
-      break;
-    }
-  }
-  return index;
+  std::size_t index = SearchUtils::simd_find(arr.data(), arr.size(), target);
+  return index == arr.size() ? -1 : static_cast<int>(index);
 }
 
 int binarySearch(const std::vector<int> &arr, const int &target) {
@@ -26,6 +21,25 @@ int binarySearch(const std::vector<int> &arr, const int &target) {
   return -1;
 }
 
+/**
+ * @brief 批量二分查找, 各查询交错推进; out[i] 为 targets[i] 的下标, 不存在时为-1
+ *
+ * @param arr 有序数组
+ * @param targets
+ * @param out 长度不小于 targets 的长度
+ */
+void binarySearch(const std::vector<int> &arr, std::span<const int> targets,
+                  std::span<int> out) {
+  std::less<> comp;
+  SearchUtils::detail::interleaved_lower_bound(
+      arr.data(), arr.size(), targets.data(), targets.size(), comp,
+      [&](std::size_t i, std::size_t pos) {
+        out[i] = pos < arr.size() && arr[pos] == targets[i]
+                     ? static_cast<int>(pos)
+                     : -1;
+      });
+}
+
 int fibonacciSearch(const std::vector<int> &arr, const int &target) {
   int n = arr.size();
   int fibMMm2 = 0, fibMMm1 = 1, fibM = fibMMm2 + fibMMm1;
@@ -59,8 +73,12 @@ int fibonacciSearch(const std::vector<int> &arr, const int &target) {
 int interpolationSearch(const std::vector<int> &arr, const int &target) {
   int left = 0, right = arr.size() - 1;
   while (left <= right && arr[left] <= target && arr[right] >= target) {
-    int pos =
-        left + (target - arr[left]) * (right - left) / (arr[right] - arr[left]);
+    if (arr[left] == arr[right]) // 区间内全部等于 target
+      return left;
+    // 差值小于 2^32, 乘积小于 2^63, 用64位计算避免溢出
+    const std::int64_t offset = std::int64_t(target) - arr[left];
+    const std::int64_t span = std::int64_t(arr[right]) - arr[left];
+    int pos = left + static_cast<int>(offset * (right - left) / span);
     if (arr[pos] == target) {
       return pos;
     } else if (arr[pos] < target) {
@@ -70,4 +88,20 @@ int interpolationSearch(const std::vector<int> &arr, const int &target) {
     }
   }
   return -1;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 学习型索引模式: 由分段线性模型预测位置, 只在误差窗口内查找;
+ * 插值查找相当于只有一段的模型, 键分布不均时误差无界
+ *
+ * @param index 有序数组上构建的索引, 查找的就是它引用的数组
+ * @param target
+ * @return int 下标, 不存在时为-1
+ */
+int interpolationSearch(const SearchUtils::PgmIndex<int> &index,
+                        const int &target) {
+  std::size_t pos = index.lower_bound(target);
+  return pos < index.size() && index.data()[pos] == target
+             ? static_cast<int>(pos)
+             : -1;
+}
@@ -0,0 +1,201 @@
+#include "utils/simd_search.h"
+#include <bit>
+#include <climits>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SEARCH_UTILS_X86 1
+#include <immintrin.h>
+#endif
+
+// k叉查找每轮: 区间 [lo, lo + len) 按 step = len / 17 取分隔元素 data[lo + (j+1)*step - 1], j = 0..15
+// 有序数组中小于目标的分隔元素构成前缀, 其个数 c 决定下一轮区间:
+// c < 16 时为 [lo + c*step, lo + (c+1)*step), 否则为 [lo + 16*step, lo + len)
+namespace SearchUtils {
+namespace {
+std::size_t scalar_find(const int *data, std::size_t n, int target) {
+  for (std::size_t i = 0; i < n; ++i)
+    if (data[i] == target)
+      return i;
+  return n;
+}
+
+/**
+ * @brief 有序区间中小于 target 的元素个数(无分支)
+ */
+std::size_t scalar_count_less(const int *data, std::size_t n, int target) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < n; ++i)
+    count += data[i] < target;
+  return count;
+}
+
+/**
+ * @brief 一轮k叉查找: 缩小 [lo, lo + len)
+ */
+void scalar_kary_step(const int *data, std::size_t &lo, std::size_t &len,
+                      int target) {
+  const std::size_t step = len / (detail::kKaryFanout + 1);
+  std::size_t c = 0;
+  for (std::size_t j = 1; j <= detail::kKaryFanout; ++j)
+    c += data[lo + j * step - 1] < target;
+  lo += c * step;
+  len = c < detail::kKaryFanout ? step : len - c * step;
+}
+
+std::size_t scalar_lower_bound(const int *data, std::size_t n, int target) {
+  std::size_t lo = 0, len = n;
+  while (len > detail::kLinearSearchMax)
+    scalar_kary_step(data, lo, len, target);
+  return lo + scalar_count_less(data + lo, len, target);
+}
+
+#if SEARCH_UTILS_X86
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,popcnt"))),       \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+#endif
+
+// 每轮比较4个向量(32个元素), 掩码合并后只做一次判断
+std::size_t avx2_find(const int *data, std::size_t n, int target) {
+  const __m256i key = _mm256_set1_epi32(target);
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i eq[4];
+    for (int k = 0; k < 4; ++k)
+      eq[k] = _mm256_cmpeq_epi32(
+          key, _mm256_loadu_si256(
+                   reinterpret_cast<const __m256i *>(data + i + 8 * k)));
+    __m256i any = _mm256_or_si256(_mm256_or_si256(eq[0], eq[1]),
+                                  _mm256_or_si256(eq[2], eq[3]));
+    if (!_mm256_testz_si256(any, any)) {
+      for (int k = 0; k < 4; ++k) {
+        auto mask = static_cast<unsigned>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(eq[k])));
+        if (mask != 0)
+          return i + 8 * k + static_cast<std::size_t>(std::countr_zero(mask));
+      }
+    }
+  }
+  for (; i + 8 <= n; i += 8) {
+    const __m256i eq = _mm256_cmpeq_epi32(
+        key, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i)));
+    auto mask =
+        static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+    if (mask != 0)
+      return i + static_cast<std::size_t>(std::countr_zero(mask));
+  }
+  return i + scalar_find(data + i, n - i, target);
+}
+
+// 比较结果为-1(真)或0, 直接累加后取反即为计数
+std::size_t avx2_count_less(const int *data, std::size_t n, int target) {
+  const __m256i key = _mm256_set1_epi32(target);
+  __m256i acc = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    acc = _mm256_add_epi32(
+        acc, _mm256_cmpgt_epi32(key, _mm256_loadu_si256(
+                                         reinterpret_cast<const __m256i *>(
+                                             data + i))));
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                              _mm256_extracti128_si256(acc, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+  const auto count = static_cast<std::size_t>(-_mm_cvtsi128_si32(sum));
+  return count + scalar_count_less(data + i, n - i, target);
+}
+
+// 两次 gather 取16个分隔元素, 比较掩码的置位数即为小于目标的个数
+std::size_t avx2_lower_bound(const int *data, std::size_t n, int target) {
+  const __m256i key = _mm256_set1_epi32(target);
+  const __m256i lanes_lo = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8);
+  const __m256i lanes_hi = _mm256_setr_epi32(9, 10, 11, 12, 13, 14, 15, 16);
+  const __m256i one = _mm256_set1_epi32(1);
+  std::size_t lo = 0, len = n;
+  while (len > detail::kLinearSearchMax) {
+    if (len > static_cast<std::size_t>(INT_MAX)) { // gather 偏移为32位
+      scalar_kary_step(data, lo, len, target);
+      continue;
+    }
+    const std::size_t step = len / (detail::kKaryFanout + 1);
+    const __m256i stride = _mm256_set1_epi32(static_cast<int>(step));
+    const __m256i a = _mm256_i32gather_epi32(
+        data + lo, _mm256_sub_epi32(_mm256_mullo_epi32(lanes_lo, stride), one),
+        4);
+    const __m256i b = _mm256_i32gather_epi32(
+        data + lo, _mm256_sub_epi32(_mm256_mullo_epi32(lanes_hi, stride), one),
+        4);
+    const auto mask =
+        static_cast<unsigned>(_mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpgt_epi32(key, a)))) |
+        static_cast<unsigned>(_mm256_movemask_ps(
+            _mm256_castsi256_ps(_mm256_cmpgt_epi32(key, b))))
+            << 8;
+    const auto c = static_cast<std::size_t>(std::popcount(mask));
+    lo += c * step;
+    len = c < detail::kKaryFanout ? step : len - c * step;
+  }
+  return lo + avx2_count_less(data + lo, len, target);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif // SEARCH_UTILS_X86
+
+bool detect_avx2() {
+#if SEARCH_UTILS_X86
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+using Kernel = std::size_t (*)(const int *, std::size_t, int);
+
+Kernel resolve_find_kernel() {
+#if SEARCH_UTILS_X86
+  if (detect_avx2())
+    return avx2_find;
+#endif
+  return scalar_find;
+}
+
+Kernel resolve_lower_bound_kernel() {
+#if SEARCH_UTILS_X86
+  if (detect_avx2())
+    return avx2_lower_bound;
+#endif
+  return scalar_lower_bound;
+}
+} // namespace
+
+std::size_t simd_find(const int *data, std::size_t n, int target) {
+  static const Kernel kernel = resolve_find_kernel();
+  return kernel(data, n, target);
+}
+
+std::size_t simd_lower_bound(const int *data, std::size_t n, int target) {
+  static const Kernel kernel = resolve_lower_bound_kernel();
+  return kernel(data, n, target);
+}
+
+bool simd_search_uses_avx2() { return detect_avx2(); }
+
+namespace detail {
+std::size_t simd_find_scalar(const int *data, std::size_t n, int target) {
+  return scalar_find(data, n, target);
+}
+
+std::size_t simd_lower_bound_scalar(const int *data, std::size_t n,
+                                    int target) {
+  return scalar_lower_bound(data, n, target);
+}
+} // namespace detail
+} // namespace SearchUtils
@@ -0,0 +1,210 @@
+#include "utils/static_btree.h"
+#include "utils/aligned_allocator.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SEARCH_UTILS_X86 1
+#include <immintrin.h>
+#endif
+
+// 布局: 第0层为叶子(有序数组, 末尾用 INT_MAX 补齐到16的倍数), 第 h 层的键数由第 h-1 层的节点数决定,
+// 直到某层不超过16个键(根). 第 h 层节点 k 的第 i 个键为其第 i+1 个子节点所在子树的最小键,
+// 查找时节点内小于 x 的键数 i 就是要进入的子节点 k * 17 + i;
+// 到达叶子 k 后下标为 k * 16 + (叶子内小于 x 的键数), 恰为 lower_bound(为16时落在下一个叶子的开头)
+namespace SearchUtils {
+namespace {
+constexpr std::size_t kKeys = detail::kBTreeNodeKeys;
+
+constexpr std::size_t blocks(std::size_t n) { return (n + kKeys - 1) / kKeys; }
+
+// 上一层的键数
+constexpr std::size_t prev_keys(std::size_t n) {
+  return (blocks(n) + kKeys) / (kKeys + 1) * kKeys;
+}
+
+std::size_t scalar_node_rank(const int *node, int x) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < kKeys; ++i)
+    count += node[i] < x;
+  return count;
+}
+
+std::size_t scalar_descend(const int *keys, const std::size_t *offsets,
+                           std::size_t height, int x) {
+  std::size_t k = 0;
+  for (std::size_t h = height - 1; h > 0; --h)
+    k = k * (kKeys + 1) + scalar_node_rank(keys + offsets[h] + k * kKeys, x);
+  return k * kKeys + scalar_node_rank(keys + k * kKeys, x);
+}
+
+#if SEARCH_UTILS_X86
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,popcnt"))),       \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+#endif
+
+// 节点按缓存行对齐, 两次对齐加载即取到全部16个键
+inline std::size_t avx2_node_rank(const int *node, __m256i key) {
+  const __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i *>(node));
+  const __m256i b =
+      _mm256_load_si256(reinterpret_cast<const __m256i *>(node + 8));
+  const auto mask =
+      static_cast<unsigned>(_mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpgt_epi32(key, a)))) |
+      static_cast<unsigned>(_mm256_movemask_ps(
+          _mm256_castsi256_ps(_mm256_cmpgt_epi32(key, b))))
+          << 8;
+  return static_cast<std::size_t>(std::popcount(mask));
+}
+
+std::size_t avx2_descend(const int *keys, const std::size_t *offsets,
+                         std::size_t height, int x) {
+  const __m256i key = _mm256_set1_epi32(x);
+  std::size_t k = 0;
+  for (std::size_t h = height - 1; h > 0; --h)
+    k = k * (kKeys + 1) + avx2_node_rank(keys + offsets[h] + k * kKeys, key);
+  return k * kKeys + avx2_node_rank(keys + k * kKeys, key);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+#endif // SEARCH_UTILS_X86
+
+bool detect_avx2() {
+#if SEARCH_UTILS_X86
+  return __builtin_cpu_supports("avx2");
+#else
+  return false;
+#endif
+}
+
+using Kernel = std::size_t (*)(const int *, const std::size_t *, std::size_t,
+                               int);
+
+Kernel resolve_kernel() {
+#if SEARCH_UTILS_X86
+  if (detect_avx2())
+    return avx2_descend;
+#endif
+  return scalar_descend;
+}
+} // namespace
+
+StaticBTree::StaticBTree(const int *sorted, std::size_t n) : n_(n) {
+  if (n == 0)
+    return;
+  // 各层起始位置, 最后一层只有一个节点
+  std::size_t total = 0;
+  for (std::size_t keys = n;; keys = prev_keys(keys)) {
+    offsets_.push_back(total);
+    total += blocks(keys) * kKeys;
+    if (keys <= kKeys)
+      break;
+  }
+
+  bytes_ = total * sizeof(int);
+  align_ = detail::kCacheLine;
+  if (bytes_ >= detail::kHugePage) {
+    align_ = detail::kHugePage;
+    bytes_ = (bytes_ + align_ - 1) / align_ * align_;
+  }
+  keys_ = static_cast<int *>(::operator new(bytes_, std::align_val_t{align_}));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (align_ == detail::kHugePage)
+    madvise(keys_, bytes_, MADV_HUGEPAGE); // 失败时仍用普通页
+#endif
+
+  std::copy(sorted, sorted + n, keys_);
+  std::fill(keys_ + n, keys_ + blocks(n) * kKeys, INT_MAX);
+  const std::size_t height = offsets_.size();
+  for (std::size_t h = 1; h < height; ++h) {
+    const std::size_t end = h + 1 < height ? offsets_[h + 1] : total;
+    for (std::size_t i = 0; i < end - offsets_[h]; ++i) {
+      // 第 i 个键对应的右侧子节点, 再一路取最左子节点直到叶子
+      std::size_t k = i / kKeys * (kKeys + 1) + i % kKeys + 1;
+      for (std::size_t l = 1; l < h; ++l)
+        k *= kKeys + 1;
+      keys_[offsets_[h] + i] = k * kKeys < n ? keys_[k * kKeys] : INT_MAX;
+    }
+  }
+}
+
+StaticBTree::StaticBTree(const std::vector<int> &sorted)
+    : StaticBTree(sorted.data(), sorted.size()) {}
+
+StaticBTree::StaticBTree(StaticBTree &&other) noexcept
+    : keys_(std::exchange(other.keys_, nullptr)),
+      n_(std::exchange(other.n_, 0)), bytes_(std::exchange(other.bytes_, 0)),
+      align_(std::exchange(other.align_, 0)),
+      offsets_(std::move(other.offsets_)) {}
+
+StaticBTree &StaticBTree::operator=(StaticBTree &&other) noexcept {
+  if (this != &other) {
+    release();
+    keys_ = std::exchange(other.keys_, nullptr);
+    n_ = std::exchange(other.n_, 0);
+    bytes_ = std::exchange(other.bytes_, 0);
+    align_ = std::exchange(other.align_, 0);
+    offsets_ = std::move(other.offsets_);
+  }
+  return *this;
+}
+
+StaticBTree::~StaticBTree() { release(); }
+
+void StaticBTree::release() {
+  if (keys_ != nullptr)
+    ::operator delete(keys_, bytes_, std::align_val_t{align_});
+  keys_ = nullptr;
+  offsets_.clear();
+}
+
+std::size_t StaticBTree::lower_bound(int x) const {
+  static const Kernel kernel = resolve_kernel();
+  if (n_ == 0)
+    return 0;
+  return std::min(kernel(keys_, offsets_.data(), offsets_.size(), x), n_);
+}
+
+std::size_t StaticBTree::upper_bound(int x) const {
+  return x == INT_MAX ? n_ : lower_bound(x + 1);
+}
+
+bool StaticBTree::contains(int x) const {
+  const std::size_t i = lower_bound(x);
+  return i < n_ && keys_[i] == x;
+}
+
+std::span<const int> StaticBTree::range(int lo, int hi) const {
+  if (!(lo < hi))
+    return {};
+  const std::size_t first = lower_bound(lo);
+  return {keys_ + first, lower_bound(hi) - first};
+}
+
+bool static_btree_uses_avx2() { return detect_avx2(); }
+
+namespace detail {
+std::size_t static_btree_lower_bound_scalar(const StaticBTree &tree, int x) {
+  if (tree.n_ == 0)
+    return 0;
+  return std::min(scalar_descend(tree.keys_, tree.offsets_.data(),
+                                 tree.offsets_.size(), x),
+                  tree.n_);
+}
+} // namespace detail
+} // namespace SearchUtils
@@ -47,10 +47,12 @@ BTreeNode *create_tree(const std::vector<NodeVal> &vals) {
  * @brief Level order traversal of a binary tree.
  *
  * @param root
+ * @param visit 按层序对每个节点调用, 可为空
  * @return true
  * @return false
  */
-bool levelorderTraversal(BTreeNode *root) {
+bool levelorderTraversal(BTreeNode *root,
+                         const std::function<void(BTreeNode *)> &visit) {
   if (is_empty(root)) {
     return false;
   }
@@ -59,7 +61,9 @@ bool levelorderTraversal(BTreeNode *root) {
   while (!q.empty()) {
     BTreeNode *node = q.front();
     q.pop();
-    std::cout << node->val << " ";
+    if (visit) {
+      visit(node);
+    }
     if (node->left) {
       q.push(node->left);
     }
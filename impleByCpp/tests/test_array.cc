@@ -1,6 +1,18 @@
 #include "core_api/array_utils.h"
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
 // bubble_sort
@@ -93,3 +105,893 @@ TEST(ArrayTest, radix_sort) {
   ArrayUtils::printList(list);
   EXPECT_TRUE(list == expected);
 }
+
+// introsort: 有序/逆序/重复值/风琴管等对抗输入
+TEST(ArrayTest, introsort_adversarial) {
+  const int n = 100000;
+  std::vector<std::vector<int>> inputs(4, std::vector<int>(n));
+  for (int i = 0; i < n; ++i) {
+    inputs[0][i] = i;
+    inputs[1][i] = n - i;
+    inputs[2][i] = 7;
+    inputs[3][i] = i < n / 2 ? i : n - i;
+  }
+  for (auto &list : inputs) {
+    std::vector<int> expected = list;
+    std::sort(expected.begin(), expected.end());
+    ArrayUtils::quick_sort(list, 0, list.size() - 1);
+    EXPECT_TRUE(list == expected);
+  }
+}
+
+// introsort: 64位键与自定义比较器
+TEST(ArrayTest, introsort_generic) {
+  std::mt19937_64 rng(42);
+  std::vector<std::uint64_t> keys(50000);
+  for (auto &k : keys)
+    k = rng();
+  std::vector<std::uint64_t> expected = keys;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  ArrayUtils::introsort(keys.begin(), keys.end(), std::greater<>());
+  EXPECT_TRUE(keys == expected);
+
+  struct Record {
+    std::int64_t key;
+    std::string name;
+  };
+  std::vector<Record> records;
+  for (int i = 0; i < 1000; ++i)
+    records.push_back({static_cast<std::int64_t>(rng() % 100),
+                       std::to_string(i)});
+  ArrayUtils::introsort(records.begin(), records.end(),
+                        [](const Record &a, const Record &b) {
+                          return a.key < b.key;
+                        });
+  EXPECT_TRUE(std::is_sorted(
+      records.begin(), records.end(),
+      [](const Record &a, const Record &b) { return a.key < b.key; }));
+}
+
+// parallel_merge_sort: 多线程, 小粒度, 稳定性
+TEST(ArrayTest, parallel_merge_sort) {
+  std::mt19937 rng(7);
+  std::vector<std::pair<int, int>> list(200003);
+  for (std::size_t i = 0; i < list.size(); ++i)
+    list[i] = {static_cast<int>(rng() % 1000), static_cast<int>(i)};
+  auto expected = list;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  ArrayUtils::ThreadPool pool(4);
+  ArrayUtils::ParallelSortOptions options;
+  options.grain = 1000;
+  ArrayUtils::parallel_merge_sort(
+      list.begin(), list.end(),
+      [](const auto &a, const auto &b) { return a.first < b.first; }, options,
+      pool);
+  EXPECT_TRUE(list == expected);
+}
+
+// ParallelSortOptions::threads 限制实际参与执行的线程数, 即使任务数多于它
+TEST(ArrayTest, parallel_threads_limit) {
+  ArrayUtils::ThreadPool pool(4);
+  std::mutex mutex;
+  std::set<std::thread::id> seen;
+  auto record = [&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    seen.insert(std::this_thread::get_id());
+  };
+  pool.parallel_for(
+      64,
+      [&](std::size_t) {
+        record();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      },
+      2);
+  EXPECT_LE(seen.size(), 2u);
+
+  std::mt19937 rng(9);
+  std::vector<int> list(100000);
+  for (auto &x : list)
+    x = static_cast<int>(rng());
+  auto expected = list;
+  std::sort(expected.begin(), expected.end());
+  ArrayUtils::ParallelSortOptions options;
+  options.threads = 2;
+  options.grain = 1000;
+  auto less = [&](int a, int b) {
+    record();
+    return a < b;
+  };
+  auto merge_list = list;
+  seen.clear();
+  ArrayUtils::parallel_merge_sort(merge_list.begin(), merge_list.end(), less,
+                                  options, pool);
+  EXPECT_TRUE(merge_list == expected);
+  EXPECT_LE(seen.size(), 2u);
+  seen.clear();
+  ArrayUtils::parallel_sample_sort(list.begin(), list.end(), less, options,
+                                   pool);
+  EXPECT_TRUE(list == expected);
+  EXPECT_LE(seen.size(), 2u);
+}
+
+// radix_sort: 负数, 64位无符号键, 浮点数, 不同位宽
+TEST(ArrayTest, radix_sort_keys) {
+  std::mt19937_64 rng(3);
+  std::vector<int> ints(10000);
+  for (auto &x : ints)
+    x = static_cast<int>(rng());
+  ints.push_back(std::numeric_limits<int>::min());
+  ints.push_back(std::numeric_limits<int>::max());
+  auto expected_ints = ints;
+  std::sort(expected_ints.begin(), expected_ints.end());
+  auto ints16 = ints;
+  ArrayUtils::radix_sort(ints);
+  ArrayUtils::radix_sort<16>(ints16.begin(), ints16.end());
+  EXPECT_TRUE(ints == expected_ints);
+  EXPECT_TRUE(ints16 == expected_ints);
+
+  std::vector<std::uint64_t> keys(10000);
+  for (auto &k : keys)
+    k = rng() >> (rng() % 64);
+  auto expected_keys = keys;
+  std::sort(expected_keys.begin(), expected_keys.end());
+  ArrayUtils::radix_sort<11>(keys.begin(), keys.end());
+  EXPECT_TRUE(keys == expected_keys);
+
+  std::vector<float> floats{3.5f, -0.0f, -2.25f, 0.0f, 1e30f, -1e30f,
+                            std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(), 1e-40f};
+  for (int i = 0; i < 1000; ++i)
+    floats.push_back(static_cast<float>(static_cast<std::int64_t>(rng())) /
+                     1e9f);
+  auto expected_floats = floats;
+  std::stable_sort(expected_floats.begin(), expected_floats.end());
+  ArrayUtils::radix_sort(floats.begin(), floats.end());
+  EXPECT_TRUE(std::is_sorted(floats.begin(), floats.end()));
+  EXPECT_TRUE(std::is_permutation(floats.begin(), floats.end(),
+                                  expected_floats.begin()));
+
+  std::vector<double> doubles{2.0, -1.5, 0.25, -1e300, 1e300, -0.125};
+  ArrayUtils::radix_sort(doubles.begin(), doubles.end());
+  EXPECT_TRUE(std::is_sorted(doubles.begin(), doubles.end()));
+}
+
+// parallel_radix_sort: 多块分发与写合并缓冲
+TEST(ArrayTest, parallel_radix_sort) {
+  std::mt19937 rng(11);
+  std::vector<int> list(300007);
+  for (auto &x : list)
+    x = static_cast<int>(rng());
+  auto expected = list;
+  std::sort(expected.begin(), expected.end());
+
+  ArrayUtils::ThreadPool pool(4);
+  ArrayUtils::ParallelSortOptions options;
+  options.grain = 1000;
+  auto list11 = list;
+  ArrayUtils::parallel_radix_sort(list.begin(), list.end(), options, pool);
+  ArrayUtils::parallel_radix_sort<11>(list11.begin(), list11.end(), options,
+                                      pool);
+  EXPECT_TRUE(list == expected);
+  EXPECT_TRUE(list11 == expected);
+
+  std::vector<std::uint32_t> narrow(100000);
+  for (auto &x : narrow)
+    x = rng() % 300; // 高位全为0, 触发平凡趟跳过
+  auto expected_narrow = narrow;
+  std::sort(expected_narrow.begin(), expected_narrow.end());
+  ArrayUtils::parallel_radix_sort(narrow.begin(), narrow.end(), options, pool);
+  EXPECT_TRUE(narrow == expected_narrow);
+}
+
+// 键值排序: argsort + 置换, 以及键/值并行数组
+TEST(ArrayTest, sort_by_key) {
+  struct Record {
+    std::int64_t key;
+    char payload[92];
+  };
+  std::mt19937_64 rng(5);
+  std::vector<Record> records(5000);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    records[i].key = static_cast<std::int64_t>(rng() % 2000) - 1000;
+    std::snprintf(records[i].payload, sizeof(records[i].payload), "%zu", i);
+  }
+  auto by_key = [](const Record &a, const Record &b) { return a.key < b.key; };
+  auto expected = records;
+  std::stable_sort(expected.begin(), expected.end(), by_key);
+  auto key_of = [](const Record &r) { return r.key; };
+
+  for (int variant = 0; variant < 3; ++variant) {
+    auto list = records;
+    std::vector<std::size_t> perm;
+    if (variant == 0)
+      perm = ArrayUtils::argsort(list.begin(), list.end(), std::less<>(),
+                                 key_of);
+    else if (variant == 1)
+      perm = ArrayUtils::stable_argsort(list.begin(), list.end(),
+                                        std::less<>(), key_of);
+    else
+      perm = ArrayUtils::radix_argsort(list.begin(), list.end(), key_of);
+    ArrayUtils::apply_permutation(list.begin(), list.end(), perm);
+    EXPECT_TRUE(std::is_sorted(list.begin(), list.end(), by_key));
+    if (variant != 0) { // 稳定版本需与 std::stable_sort 完全一致
+      for (std::size_t i = 0; i < list.size(); ++i)
+        EXPECT_STREQ(list[i].payload, expected[i].payload);
+    }
+  }
+
+  std::vector<int> keys{5, -3, 8, 5, 0, -3};
+  std::vector<std::string> values{"a", "b", "c", "d", "e", "f"};
+  ArrayUtils::radix_sort_by_key(keys.begin(), keys.end(), values.begin());
+  EXPECT_TRUE((keys == std::vector<int>{-3, -3, 0, 5, 5, 8}));
+  EXPECT_TRUE(
+      (values == std::vector<std::string>{"b", "f", "e", "a", "d", "c"}));
+
+  keys = {5, -3, 8, 5, 0, -3};
+  values = {"a", "b", "c", "d", "e", "f"};
+  ArrayUtils::stable_sort_by_key(keys.begin(), keys.end(), values.begin(),
+                                 std::greater<>());
+  EXPECT_TRUE(
+      (values == std::vector<std::string>{"c", "a", "d", "e", "b", "f"}));
+}
+
+// small_sort: 排序网络(运行时分派与标量版本)覆盖 0..64 的所有长度
+TEST(ArrayTest, small_sort) {
+  std::mt19937 rng(13);
+  for (std::size_t n = 0; n <= ArrayUtils::kSmallSortMax; ++n) {
+    std::vector<int> ints(n);
+    std::vector<float> floats(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      ints[i] = static_cast<int>(rng()) % 50;
+      floats[i] = static_cast<float>(static_cast<int>(rng() % 2001) - 1000) / 8;
+    }
+    if (n > 2) {
+      ints[0] = std::numeric_limits<int>::max();
+      ints[1] = std::numeric_limits<int>::min();
+      floats[0] = std::numeric_limits<float>::infinity();
+    }
+    auto expected_ints = ints;
+    auto expected_floats = floats;
+    std::sort(expected_ints.begin(), expected_ints.end());
+    std::sort(expected_floats.begin(), expected_floats.end());
+
+    auto scalar_ints = ints;
+    auto scalar_floats = floats;
+    ArrayUtils::small_sort(ints.data(), n);
+    ArrayUtils::small_sort(floats.data(), n);
+    ArrayUtils::detail::small_sort_scalar(scalar_ints.data(), n);
+    ArrayUtils::detail::small_sort_scalar(scalar_floats.data(), n);
+    EXPECT_TRUE(ints == expected_ints) << "n = " << n;
+    EXPECT_TRUE(floats == expected_floats) << "n = " << n;
+    EXPECT_TRUE(scalar_ints == expected_ints) << "n = " << n;
+    EXPECT_TRUE(scalar_floats == expected_floats) << "n = " << n;
+  }
+}
+
+// simd_partition: 向量/标量分区结果一致, 以及 simd 分区策略的快排与选择
+TEST(ArrayTest, simd_partition) {
+  std::mt19937 rng(17);
+  for (std::size_t n : {0, 1, 7, 15, 16, 17, 33, 100, 1000, 4099}) {
+    std::vector<int> ints(n);
+    for (auto &x : ints)
+      x = static_cast<int>(rng() % 64);
+    for (bool inclusive : {false, true}) {
+      auto simd = ints;
+      auto scalar = ints;
+      std::size_t k = ArrayUtils::simd_partition(simd.data(), n, 31, inclusive);
+      std::size_t k2 = ArrayUtils::detail::simd_partition_scalar(
+          scalar.data(), n, 31, inclusive);
+      auto left = [&](int x) { return inclusive ? x <= 31 : x < 31; };
+      EXPECT_EQ(k, k2);
+      EXPECT_EQ(k, std::count_if(ints.begin(), ints.end(), left));
+      EXPECT_TRUE(std::all_of(simd.begin(), simd.begin() + k, left));
+      EXPECT_TRUE(std::none_of(simd.begin() + k, simd.end(), left));
+      EXPECT_TRUE(std::is_permutation(simd.begin(), simd.end(), ints.begin()));
+    }
+  }
+
+  std::vector<float> floats(3001);
+  for (auto &x : floats)
+    x = static_cast<float>(rng() % 1000) / 3;
+  auto sorted_floats = floats;
+  ArrayUtils::introsort(sorted_floats.begin(), sorted_floats.end(),
+                        std::less<>(), ArrayUtils::PartitionScheme::simd);
+  EXPECT_TRUE(std::is_sorted(sorted_floats.begin(), sorted_floats.end()));
+
+  std::vector<int> list(200000);
+  for (auto &x : list)
+    x = static_cast<int>(rng() % 100); // 大量重复值
+  auto expected = list;
+  std::sort(expected.begin(), expected.end());
+  auto sorted = list;
+  ArrayUtils::introsort(sorted.begin(), sorted.end(), std::less<>(),
+                        ArrayUtils::PartitionScheme::simd);
+  EXPECT_TRUE(sorted == expected);
+
+  for (std::size_t nth : {std::size_t(0), list.size() / 3, list.size() - 1}) {
+    auto selected = list;
+    ArrayUtils::nth_element(selected.begin(), selected.begin() + nth,
+                            selected.end(), std::less<>(),
+                            ArrayUtils::PartitionScheme::simd);
+    EXPECT_EQ(selected[nth], expected[nth]);
+    EXPECT_TRUE(std::all_of(selected.begin(), selected.begin() + nth,
+                            [&](int x) { return x <= expected[nth]; }));
+    EXPECT_TRUE(std::all_of(selected.begin() + nth, selected.end(),
+                            [&](int x) { return x >= expected[nth]; }));
+  }
+}
+
+// block_partition: 块分区与 block 分区策略的快排/选择
+TEST(ArrayTest, block_partition) {
+  std::mt19937 rng(23);
+  for (std::size_t n : {0, 1, 2, 63, 64, 128, 129, 200, 1000, 5003}) {
+    std::vector<int> list(n);
+    for (auto &x : list)
+      x = static_cast<int>(rng() % 100);
+    auto parted = list;
+    auto less50 = [](int x) { return x < 50; };
+    auto mid = ArrayUtils::block_partition(parted.begin(), parted.end(), less50);
+    EXPECT_EQ(mid - parted.begin(),
+              std::count_if(list.begin(), list.end(), less50));
+    EXPECT_TRUE(std::is_partitioned(parted.begin(), parted.end(), less50));
+    EXPECT_TRUE(std::is_permutation(parted.begin(), parted.end(), list.begin()));
+
+    if (n >= 2) {
+      auto lomuto = list;
+      int p = ArrayUtils::partition(lomuto, 0, static_cast<int>(n) - 1);
+      EXPECT_EQ(lomuto[p], list.back());
+      EXPECT_TRUE(std::all_of(lomuto.begin(), lomuto.begin() + p,
+                              [&](int x) { return x < list.back(); }));
+      EXPECT_TRUE(std::all_of(lomuto.begin() + p, lomuto.end(),
+                              [&](int x) { return x >= list.back(); }));
+    }
+  }
+
+  std::vector<int> list(300000);
+  for (auto &x : list)
+    x = static_cast<int>(rng());
+  list.resize(400000, 7); // 尾部大量重复值
+  auto expected = list;
+  std::sort(expected.begin(), expected.end());
+  auto sorted = list;
+  ArrayUtils::quick_sort(sorted, 0, static_cast<int>(sorted.size()) - 1,
+                         ArrayUtils::PartitionScheme::block);
+  EXPECT_TRUE(sorted == expected);
+
+  std::vector<std::string> words(2000);
+  for (auto &w : words)
+    w = std::to_string(rng() % 500);
+  auto expected_words = words;
+  std::sort(expected_words.begin(), expected_words.end(), std::greater<>());
+  ArrayUtils::introsort(words.begin(), words.end(), std::greater<>(),
+                        ArrayUtils::PartitionScheme::block);
+  EXPECT_TRUE(words == expected_words);
+
+  const std::size_t nth = list.size() / 2;
+  ArrayUtils::nth_element(list.begin(), list.begin() + nth, list.end(),
+                          std::less<>(), ArrayUtils::PartitionScheme::block);
+  EXPECT_EQ(list[nth], expected[nth]);
+}
+
+// adaptive_sort: 各种有序程度的输入, 以及稳定性
+TEST(ArrayTest, adaptive_sort) {
+  std::mt19937 rng(29);
+  auto check = [](std::vector<std::pair<int, int>> list) {
+    for (int i = 0; i < static_cast<int>(list.size()); ++i)
+      list[i].second = i;
+    auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+    auto expected = list;
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    ArrayUtils::adaptive_sort(list.begin(), list.end(), by_key);
+    EXPECT_TRUE(list == expected) << "n = " << list.size();
+  };
+  for (std::size_t n : {0, 1, 2, 31, 64, 65, 1000, 100000}) {
+    std::vector<std::pair<int, int>> list(n);
+    for (auto &x : list)
+      x.first = static_cast<int>(rng() % 1000000);
+    check(list); // 随机
+    auto sorted = list;
+    std::sort(sorted.begin(), sorted.end());
+    check(sorted);
+    std::reverse(sorted.begin(), sorted.end());
+    check(sorted);
+    for (std::size_t i = 0; i < n; ++i)
+      list[i].first = static_cast<int>(i % 977); // 锯齿
+    check(list);
+    for (auto &x : list)
+      x.first = static_cast<int>(rng() % 4); // 少量不同值
+    check(list);
+    for (std::size_t i = 0; i < n; ++i)
+      list[i].first = static_cast<int>(i); // 有序后追加少量乱序
+    for (std::size_t i = n - n / 16; i < n; ++i)
+      list[i].first = static_cast<int>(rng() % (n + 1));
+    check(list);
+  }
+
+  std::vector<int> ints(50000);
+  for (auto &x : ints)
+    x = static_cast<int>(rng());
+  auto expected = ints;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  ArrayUtils::adaptive_sort(ints.begin(), ints.end(), std::greater<>());
+  EXPECT_TRUE(ints == expected);
+}
+
+// stable_merge_sort: 不同缓冲区大小(含0, 完全原地)下的正确性与稳定性
+TEST(ArrayTest, stable_merge_sort_buffer_limited) {
+  std::mt19937 rng(31);
+  auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+  for (std::size_t n : {0, 1, 2, 33, 100, 4099, 50000}) {
+    std::vector<std::pair<int, int>> list(n);
+    for (int i = 0; i < static_cast<int>(n); ++i)
+      list[i] = {static_cast<int>(rng() % 64), i};
+    auto expected = list;
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    for (std::size_t buf_size : {std::size_t(0), std::size_t(1),
+                                 std::size_t(17), n / 8, (n + 1) / 2}) {
+      auto sorted = list;
+      std::vector<std::pair<int, int>> buf(buf_size);
+      ArrayUtils::stable_merge_sort(sorted.begin(), sorted.end(), buf.begin(),
+                                    static_cast<std::ptrdiff_t>(buf_size),
+                                    by_key);
+      EXPECT_TRUE(sorted == expected) << "n = " << n << " buf = " << buf_size;
+    }
+  }
+
+  std::vector<int> ints(100000);
+  for (auto &x : ints)
+    x = static_cast<int>(rng());
+  auto expected = ints;
+  std::sort(expected.begin(), expected.end());
+  ArrayUtils::stable_merge_sort(ints.begin(), ints.end(), std::size_t(1000));
+  EXPECT_TRUE(ints == expected);
+
+  std::vector<int> list{1, 4, 7, 9, 2, 3, 8, 10, 11};
+  ArrayUtils::merge(list, 0, 3, 8);
+  EXPECT_TRUE(std::is_sorted(list.begin(), list.end()));
+
+  // 调用方缓冲区: 只需容纳左段
+  list = {5, 6, 1, 2, 3, 4, 7};
+  std::vector<int> buf(2);
+  ArrayUtils::merge(list, 0, 1, 6, buf);
+  EXPECT_TRUE((list == std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+  list = {5, 6, 7, 1, 2};
+  EXPECT_THROW(ArrayUtils::merge(list, 0, 2, 4, buf), std::invalid_argument);
+}
+
+// external_sort: 小内存预算强制多个有序段与多趟归并
+TEST(ArrayTest, external_sort) {
+  namespace fs = std::filesystem;
+  const fs::path dir = fs::temp_directory_path() / "test_external_sort";
+  fs::create_directories(dir);
+  auto write_file = [](const fs::path &path, const auto &data) {
+    std::FILE *f = std::fopen(path.c_str(), "wb");
+    if (!data.empty())
+      std::fwrite(data.data(), sizeof(data[0]), data.size(), f);
+    std::fclose(f);
+  };
+  auto read_file = [](const fs::path &path, auto &data) {
+    data.resize(fs::file_size(path) / sizeof(data[0]));
+    std::FILE *f = std::fopen(path.c_str(), "rb");
+    EXPECT_EQ(std::fread(data.data(), sizeof(data[0]), data.size(), f),
+              data.size());
+    std::fclose(f);
+  };
+
+  std::mt19937 rng(37);
+  std::vector<int> ints(300000);
+  for (auto &x : ints)
+    x = static_cast<int>(rng());
+  write_file(dir / "ints.bin", ints);
+  std::sort(ints.begin(), ints.end());
+  for (bool use_mmap : {false, true}) {
+    ArrayUtils::ExternalSortOptions options;
+    options.memory_budget = 64 << 10; // 约19个有序段
+    options.io_block = 8 << 10;       // 单趟最多7路, 需要两趟
+    options.temp_dir = dir;
+    options.use_mmap = use_mmap;
+    ArrayUtils::external_sort<int>(dir / "ints.bin", dir / "ints.out",
+                                   std::less<>(), options);
+    std::vector<int> sorted;
+    read_file(dir / "ints.out", sorted);
+    EXPECT_TRUE(sorted == ints) << "mmap = " << use_mmap;
+  }
+
+  // 整体装得下时直接写出, 并支持原地排序与自定义比较器
+  std::vector<std::uint64_t> keys(5000);
+  for (auto &x : keys)
+    x = rng() % 100;
+  write_file(dir / "keys.bin", keys);
+  ArrayUtils::external_sort<std::uint64_t>(dir / "keys.bin", dir / "keys.bin",
+                                           std::greater<>());
+  std::vector<std::uint64_t> sorted_keys;
+  read_file(dir / "keys.bin", sorted_keys);
+  std::sort(keys.begin(), keys.end(), std::greater<>());
+  EXPECT_TRUE(sorted_keys == keys);
+
+  // 元素数恰为一个分块(只有一个有序段)与多一个元素(两个有序段), 含原地排序
+  for (std::size_t n : {1024, 1025}) {
+    std::vector<int> data(n);
+    for (auto &x : data)
+      x = static_cast<int>(rng());
+    ArrayUtils::ExternalSortOptions options;
+    options.memory_budget = 1024 * sizeof(int);
+    options.io_block = 256;
+    options.temp_dir = dir;
+    write_file(dir / "chunk.bin", data);
+    ArrayUtils::external_sort<int>(dir / "chunk.bin", dir / "chunk.out",
+                                   std::less<>(), options);
+    ArrayUtils::external_sort<int>(dir / "chunk.bin", dir / "chunk.bin",
+                                   std::less<>(), options);
+    std::sort(data.begin(), data.end());
+    for (const char *name : {"chunk.out", "chunk.bin"}) {
+      ASSERT_TRUE(fs::exists(dir / name)) << "n = " << n << " " << name;
+      std::vector<int> sorted;
+      read_file(dir / name, sorted);
+      EXPECT_TRUE(sorted == data) << "n = " << n << " " << name;
+    }
+    fs::remove(dir / "chunk.out");
+  }
+
+  write_file(dir / "empty.bin", std::vector<int>{});
+  ArrayUtils::external_sort<int>(dir / "empty.bin", dir / "empty.out");
+  EXPECT_EQ(fs::file_size(dir / "empty.out"), 0u);
+
+  write_file(dir / "odd.bin", std::vector<char>{1, 2, 3});
+  EXPECT_THROW(
+      ArrayUtils::external_sort<int>(dir / "odd.bin", dir / "odd.out"),
+      std::invalid_argument);
+
+  // 存放临时有序段的子目录与 output 旁的暂存文件均已删除
+  for (const auto &entry : fs::directory_iterator(dir)) {
+    EXPECT_FALSE(entry.is_directory()) << entry.path();
+    EXPECT_FALSE(entry.path().extension().string().starts_with(".tmp"))
+        << entry.path();
+  }
+  fs::remove_all(dir);
+}
+
+// multiway_merge / LoserTree: 不同路数、空区间与稳定性
+TEST(ArrayTest, multiway_merge) {
+  std::mt19937 rng(41);
+  auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+  for (std::size_t k : {0, 1, 2, 3, 5, 16, 100}) {
+    std::vector<std::vector<std::pair<int, int>>> runs(k);
+    std::vector<std::pair<int, int>> expected;
+    for (std::size_t i = 0; i < k; ++i) {
+      runs[i].resize(rng() % 50); // 允许空区间
+      for (auto &x : runs[i])
+        x = {static_cast<int>(rng() % 30), static_cast<int>(i)};
+      std::sort(runs[i].begin(), runs[i].end(), by_key);
+      expected.insert(expected.end(), runs[i].begin(), runs[i].end());
+    }
+    std::stable_sort(expected.begin(), expected.end(), by_key);
+    EXPECT_TRUE(ArrayUtils::multiway_merge(runs, by_key) == expected)
+        << "k = " << k;
+  }
+
+  // 非平凡复制类型: 树中只保存指针
+  std::vector<std::vector<std::string>> words{
+      {"b", "d", "f"}, {"a", "e"}, {}, {"c", "g", "h"}};
+  std::vector<std::string> expected_words{"a", "b", "c", "d",
+                                          "e", "f", "g", "h"};
+  EXPECT_TRUE(ArrayUtils::multiway_merge(words) == expected_words);
+
+  std::vector<int> a{9, 5, 1}, b{8, 2}, c{7, 6, 3};
+  std::vector<std::span<const int>> spans{a, b, c};
+  std::vector<int> out(8);
+  auto end = ArrayUtils::multiway_merge<int>(
+      std::span<const std::span<const int>>(spans), out.begin(),
+      std::greater<>());
+  EXPECT_EQ(end, out.end());
+  EXPECT_TRUE((out == std::vector<int>{9, 8, 7, 6, 5, 3, 2, 1}));
+}
+
+// parallel_sample_sort: 随机/重复值/自定义比较器
+TEST(ArrayTest, parallel_sample_sort) {
+  std::mt19937 rng(43);
+  ArrayUtils::ThreadPool pool(4);
+  ArrayUtils::ParallelSortOptions options;
+  options.grain = 1000;
+  for (std::size_t n : {0, 1, 100, 5000, 300000}) {
+    for (int range : {0, 3, 1000}) {
+      std::vector<int> list(n);
+      for (auto &x : list)
+        x = range == 0 ? static_cast<int>(rng())
+                       : static_cast<int>(rng() % range);
+      auto expected = list;
+      std::sort(expected.begin(), expected.end());
+      ArrayUtils::parallel_sample_sort(list.begin(), list.end(), std::less<>(),
+                                       options, pool);
+      EXPECT_TRUE(list == expected) << "n = " << n << " range = " << range;
+    }
+  }
+
+  std::vector<std::string> words(20000);
+  for (auto &w : words)
+    w = std::to_string(rng() % 100000);
+  auto expected = words;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  ArrayUtils::parallel_sample_sort(words.begin(), words.end(), std::greater<>(),
+                                   options, pool);
+  EXPECT_TRUE(words == expected);
+}
+
+// bucket_sort: 整数/浮点数, 均匀、倾斜与重复值输入
+TEST(ArrayTest, bucket_sort) {
+  std::vector<int> list{5, 3, 8, 6, 2, 7, 1, 9, 4};
+  std::vector<int> expected{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ArrayUtils::bucket_sort(list);
+  EXPECT_TRUE(list == expected);
+
+  std::mt19937_64 rng(47);
+  auto check = [](auto values) {
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    ArrayUtils::bucket_sort(values.begin(), values.end());
+    EXPECT_TRUE(values == expected) << "n = " << values.size();
+  };
+  for (std::size_t n : {0, 1, 64, 65, 1000, 300000}) {
+    std::vector<int> ints(n);
+    for (auto &x : ints)
+      x = static_cast<int>(rng());
+    check(ints);
+    for (auto &x : ints)
+      x = static_cast<int>(rng() % 5) - 2; // 少量不同值, 含负数
+    check(ints);
+
+    std::vector<float> floats(n);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (auto &x : floats)
+      x = unit(rng);
+    check(floats);
+    std::exponential_distribution<double> skew(3.0);
+    std::vector<double> doubles(n);
+    for (auto &x : doubles)
+      x = (rng() % 2 ? 1 : -1) * skew(rng);
+    check(doubles);
+
+    std::vector<std::uint64_t> hashes(n);
+    for (auto &x : hashes)
+      x = rng();
+    check(hashes);
+  }
+  // 极大范围: 缩放系数溢出时退化为内省排序
+  std::vector<double> extremes(100);
+  for (std::size_t i = 0; i < extremes.size(); ++i)
+    extremes[i] = static_cast<double>(rng() % 1000);
+  extremes[0] = -1e308;
+  extremes[1] = 1e308;
+  check(extremes);
+}
+
+// counting_sort: 自动值域, 小值域走计数, 大值域改用基数排序; 并行直方图
+TEST(ArrayTest, counting_sort) {
+  std::vector<int> list{5, 3, 8, 6, 2, 7, 1, 9, 4};
+  std::vector<int> expected{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  ArrayUtils::count_sort(list);
+  EXPECT_TRUE(list == expected);
+
+  // 越界时抛出异常且不修改输入
+  list = {5, 3, 8};
+  EXPECT_THROW(ArrayUtils::count_sort(list, 3, 7), std::out_of_range);
+  EXPECT_TRUE((list == std::vector<int>{5, 3, 8}));
+
+  std::mt19937_64 rng(59);
+  for (std::size_t n : {0, 1, 7, 33, 1000, 300000}) {
+    std::vector<int> values(n);
+    for (auto &x : values)
+      x = static_cast<int>(rng());
+    if (n > 0) {
+      auto [lo, hi] = ArrayUtils::simd_minmax(values.data(), n);
+      auto [slo, shi] =
+          ArrayUtils::detail::simd_minmax_scalar(values.data(), n);
+      EXPECT_EQ(lo, slo);
+      EXPECT_EQ(hi, shi);
+    }
+
+    ArrayUtils::ThreadPool pool(4);
+    ArrayUtils::ParallelSortOptions options{.threads = 4, .grain = 256};
+    for (int span : {1, 100, 70000, 0}) { // 0: 全 int 范围, 走基数排序
+      for (auto &x : values)
+        x = span == 0 ? static_cast<int>(rng())
+                      : static_cast<int>(rng() % span) - span / 2;
+      auto expected = values;
+      std::sort(expected.begin(), expected.end());
+      auto serial = values;
+      ArrayUtils::counting_sort(serial.begin(), serial.end());
+      EXPECT_TRUE(serial == expected) << "n = " << n << ", span = " << span;
+      ArrayUtils::counting_sort(values.begin(), values.end(), options, &pool);
+      EXPECT_TRUE(values == expected) << "n = " << n << ", span = " << span;
+    }
+  }
+  std::vector<std::uint8_t> bytes(5000);
+  for (auto &x : bytes)
+    x = static_cast<std::uint8_t>(rng());
+  auto sorted_bytes = bytes;
+  std::sort(sorted_bytes.begin(), sorted_bytes.end());
+  ArrayUtils::counting_sort(bytes.begin(), bytes.end());
+  EXPECT_TRUE(bytes == sorted_bytes);
+
+  // 64位整数的全跨度: 值域 hi - lo + 1 会回绕成0
+  std::vector<std::uint64_t> wide = {std::numeric_limits<std::uint64_t>::max(),
+                                     0, 42, 0};
+  ArrayUtils::counting_sort(wide.begin(), wide.end());
+  EXPECT_TRUE((wide == std::vector<std::uint64_t>{
+                           0, 0, 42, std::numeric_limits<std::uint64_t>::max()}));
+  std::vector<std::int64_t> signed_wide = {
+      std::numeric_limits<std::int64_t>::max(), -1,
+      std::numeric_limits<std::int64_t>::min()};
+  ArrayUtils::counting_sort(signed_wide.begin(), signed_wide.end());
+  EXPECT_TRUE((signed_wide == std::vector<std::int64_t>{
+                                  std::numeric_limits<std::int64_t>::min(), -1,
+                                  std::numeric_limits<std::int64_t>::max()}));
+}
+
+// d叉堆: 不同叉数的堆排序, 优先队列与 std::priority_queue 对照
+TEST(ArrayTest, dary_heap) {
+  std::mt19937 rng(61);
+  auto check = [](auto values) {
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    auto two = values, eight = values;
+    ArrayUtils::heap_sort<2>(two.begin(), two.end());
+    ArrayUtils::heap_sort(values.begin(), values.end());
+    ArrayUtils::heap_sort<8>(eight.begin(), eight.end());
+    EXPECT_TRUE(two == expected) << "n = " << values.size();
+    EXPECT_TRUE(values == expected) << "n = " << values.size();
+    EXPECT_TRUE(eight == expected) << "n = " << values.size();
+  };
+  for (std::size_t n : {0, 1, 2, 5, 17, 1000, 100000}) {
+    std::vector<int> ints(n);
+    for (auto &x : ints)
+      x = static_cast<int>(rng() % (n + 1));
+    check(ints);
+    std::vector<std::string> words(n);
+    for (auto &w : words)
+      w = std::to_string(rng() % 1000);
+    check(words);
+  }
+
+  ArrayUtils::PriorityQueue<std::pair<int, int>, std::greater<>> queue;
+  std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                      std::greater<>>
+      expected;
+  for (int i = 0; i < 20000; ++i) {
+    int op = static_cast<int>(rng() % 3);
+    if (op == 0 || expected.empty()) {
+      std::pair<int, int> item{static_cast<int>(rng() % 1000), i};
+      queue.push(item);
+      expected.push(item);
+    } else if (op == 1) {
+      ASSERT_EQ(queue.pop_top(), expected.top());
+      expected.pop();
+    } else {
+      std::pair<int, int> item{static_cast<int>(rng() % 1000), i};
+      ASSERT_EQ(queue.top(), expected.top());
+      queue.replace_top(item);
+      expected.pop();
+      expected.push(item);
+    }
+    ASSERT_EQ(queue.size(), expected.size());
+  }
+
+  std::vector<int> values(5000);
+  for (auto &x : values)
+    x = static_cast<int>(rng());
+  ArrayUtils::PriorityQueue<int, std::less<>, 8> built(values.begin(),
+                                                       values.end());
+  std::sort(values.begin(), values.end(), std::greater<>());
+  for (int x : values)
+    ASSERT_EQ(built.pop_top(), x);
+  EXPECT_TRUE(built.empty());
+}
+
+// 插桩模式: 比较/移动/深度/分配统计
+TEST(ArrayTest, sort_stats) {
+  std::mt19937 rng(67);
+  std::vector<int> values(10000);
+  for (auto &x : values)
+    x = static_cast<int>(rng());
+  auto sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+
+  auto introsort = [](auto first, auto last, auto comp) {
+    ArrayUtils::introsort(first, last, comp);
+    EXPECT_TRUE(std::is_sorted(first, last, comp));
+  };
+  auto stats = ArrayUtils::measure_sort(values, introsort);
+  EXPECT_GT(stats.comparisons, values.size());
+  EXPECT_GT(stats.moves, 0u);
+  EXPECT_GE(stats.max_depth, 1u);
+  EXPECT_LE(stats.max_depth, 2u * std::bit_width(values.size()) + 1);
+  EXPECT_EQ(stats.allocations, 0u);
+
+  // 已有序输入: 自适应排序只需 n-1 次比较, 不移动、不分配
+  auto adaptive = [](auto first, auto last, auto comp) {
+    ArrayUtils::adaptive_sort(first, last, comp);
+  };
+  stats = ArrayUtils::measure_sort(sorted, adaptive);
+  EXPECT_EQ(stats.comparisons, sorted.size() - 1);
+  EXPECT_EQ(stats.moves, 0u);
+  EXPECT_EQ(stats.allocations, 0u);
+  stats = ArrayUtils::measure_sort(values, adaptive);
+  EXPECT_EQ(stats.allocations, 1u);
+  EXPECT_EQ(stats.allocated_bytes, values.size() / 2 * sizeof(ArrayUtils::Counted<int>));
+
+  // 缓冲区受限的归并排序只分配一次
+  stats = ArrayUtils::measure_sort(
+      values,
+      [](auto first, auto last, auto comp) {
+        ArrayUtils::stable_merge_sort(first, last, 256, comp);
+        EXPECT_TRUE(std::is_sorted(first, last, comp));
+      },
+      std::greater<>());
+  EXPECT_EQ(stats.allocations, 1u);
+  EXPECT_EQ(stats.allocated_bytes, 256 * sizeof(ArrayUtils::Counted<int>));
+
+  // 直接使用计数比较器, 不包装元素时只统计比较与深度
+  ArrayUtils::SortStats direct;
+  auto list = values;
+  ArrayUtils::introsort(list.begin(), list.end(),
+                        ArrayUtils::CountingCompare<>(direct));
+  EXPECT_TRUE(list == sorted);
+  EXPECT_GT(direct.comparisons, 0u);
+  EXPECT_EQ(direct.moves, 0u);
+  EXPECT_GE(direct.max_depth, 1u);
+}
+
+// partial_sort / 中位数的中位数选择 / 流式与并行 top-k
+TEST(ArrayTest, top_k_selection) {
+  std::mt19937 rng(53);
+  std::vector<int> list(100000);
+  for (auto &x : list)
+    x = static_cast<int>(rng() % 50000);
+  auto expected = list;
+  std::sort(expected.begin(), expected.end());
+
+  for (std::size_t k : {std::size_t(0), std::size_t(1), std::size_t(100),
+                        std::size_t(5000), list.size() - 1, list.size()}) {
+    auto partial = list;
+    ArrayUtils::partial_sort(partial.begin(), partial.begin() + k,
+                             partial.end());
+    EXPECT_TRUE(std::equal(partial.begin(), partial.begin() + k,
+                           expected.begin()))
+        << "k = " << k;
+    EXPECT_TRUE(std::is_permutation(partial.begin(), partial.end(),
+                                    list.begin()));
+  }
+
+  // 直接以 depth_limit = 0 调用, 每轮都走中位数的中位数
+  for (std::size_t nth : {std::size_t(0), list.size() / 2, list.size() - 1}) {
+    auto selected = list;
+    std::less<> comp;
+    ArrayUtils::detail::introselect(selected.begin(), selected.begin() + nth,
+                                    selected.end(), comp,
+                                    ArrayUtils::PartitionScheme::hoare, 0);
+    EXPECT_EQ(selected[nth], expected[nth]);
+    EXPECT_TRUE(std::all_of(selected.begin(), selected.begin() + nth,
+                            [&](int x) { return x <= expected[nth]; }));
+  }
+
+  std::vector<int> largest(expected.rbegin(), expected.rbegin() + 100);
+  ArrayUtils::TopK<int, std::greater<>> stream(100);
+  for (int x : list)
+    stream.push(x);
+  EXPECT_TRUE(stream.sorted() == largest);
+  EXPECT_EQ(stream.threshold(), largest.back());
+  EXPECT_TRUE(ArrayUtils::top_k(list.begin(), list.end(), 100,
+                                std::greater<>()) == largest);
+
+  ArrayUtils::ThreadPool pool(4);
+  ArrayUtils::ParallelSortOptions options;
+  options.grain = 1000;
+  EXPECT_TRUE(ArrayUtils::parallel_top_k(list.begin(), list.end(), 100,
+                                         std::greater<>(), options,
+                                         pool) == largest);
+  auto few = ArrayUtils::top_k(list.begin(), list.begin() + 10, 100);
+  EXPECT_EQ(few.size(), 10u);
+  EXPECT_TRUE(std::is_sorted(few.begin(), few.end()));
+}
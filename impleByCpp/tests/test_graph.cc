@@ -1,5 +1,8 @@
 #include "core_api/graph_utils.h"
+#include "utils/log.h"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <string>
 
 directed_graph_utils::Graph
     graph(8, 14); // create a graph with 8 vertices and 10 edges
@@ -109,7 +112,11 @@ TEST(GraphTest, BFS) {
       {{'G', 'B'}, 6}, {{'H', 'C'}, 4}};
   graph.initGraph(vertexList, edgeList2);
   graph.printGraph();
-  EXPECT_TRUE(graph.BFS('G'));
+  std::vector<VertexType> order;
+  EXPECT_TRUE(graph.BFS('G', [&](VertexType v) { order.push_back(v); }));
+  EXPECT_EQ(order, (std::vector<VertexType>{'G', 'H', 'B', 'C', 'D', 'E', 'F',
+                                            'A'}));
+  EXPECT_FALSE(graph.BFS('Z', [&](VertexType v) { order.push_back(v); }));
 }
 
 TEST(GraphTest, DFS) {
@@ -122,8 +129,29 @@ TEST(GraphTest, DFS) {
       {{'G', 'B'}, 6}, {{'H', 'C'}, 4}};
   graph.initGraph(vertexList, edgeList2);
   graph.printGraph();
-  EXPECT_EQ(graph.DFS('B'), true);
-  EXPECT_EQ(graph.DFS_recursive('C'), true);
+  std::vector<VertexType> order;
+  auto collect = [&](VertexType v) { order.push_back(v); };
+  EXPECT_EQ(graph.DFS('B', collect), true);
+  EXPECT_EQ(order, (std::vector<VertexType>{'B', 'D', 'E', 'F', 'A', 'C'}));
+  order.clear();
+  EXPECT_EQ(graph.DFS_recursive('C', collect), true);
+  EXPECT_EQ(order, (std::vector<VertexType>{'C', 'E', 'F', 'B', 'D', 'A'}));
+}
+
+// 访问器为空时各遍历都只做遍历, 不抛 std::bad_function_call
+TEST(GraphTest, emptyVisitor) {
+  directed_graph_utils::Graph graph(3, 2);
+  std::vector<VertexType> vertexList{'A', 'B', 'C'};
+  std::map<std::pair<VertexType, VertexType>, EdgeType> edgeList2 = {
+      {{'A', 'B'}, 1}, {{'B', 'C'}, 1}};
+  graph.initGraph(vertexList, edgeList2);
+  EXPECT_TRUE(graph.DFS('A', {}));
+  EXPECT_TRUE(graph.DFS_recursive('A', {}));
+  EXPECT_TRUE(graph.BFS('A', {}));
+
+  common_graph_utils::Matrix matrix(false, false, 3, 2);
+  matrix.initMatrix(vertexList, edgeList2);
+  EXPECT_NO_THROW(matrix.DFS('A', {}));
 }
 
 TEST(GraphTest, CycleProbe) {
@@ -133,6 +161,9 @@ TEST(GraphTest, CycleProbe) {
       {{'A', 'B'}, 1}, {{'B', 'C'}, 1}, {{'C', 'A'}, 1}};
   graph.initGraph(vertexList, edgeList2);
   EXPECT_TRUE(graph.is_cyclic());
+  ASSERT_EQ(graph.getCycles().size(), 1);
+  EXPECT_EQ(graph.getCycles()[0],
+            (std::vector<VertexType>{'A', 'B', 'C', 'A'}));
 }
 
 TEST(GraphTest, connectedComponents) {
@@ -153,5 +184,21 @@ TEST(GraphTest, topologicalSort){
       {{'A', 'B'}, 1}, {{'A', 'C'}, 3}, {{'B', 'D'}, 4},
       {{'C', 'D'}, 2}, {{'D', 'E'}, 5}, {{'E', 'F'}, 6}};
   graph.initGraph(vertexList, edgeList2);
-  graph.topologicalSort();
+  auto order = graph.topologicalSort();
+  ASSERT_EQ(order.size(), vertexList.size());
+  auto rank = [&](VertexType v) {
+    return std::find(order.begin(), order.end(), v) - order.begin();
+  };
+  for (const auto &[edge, weight] : edgeList2)
+    EXPECT_LT(rank(edge.first), rank(edge.second));
+}
+
+// 日志默认编译期关闭: 图操作不调用 sink
+TEST(GraphTest, logPolicy) {
+  static int messages = 0;
+  auto saved = log_utils::set_sink([](const std::string &) { ++messages; });
+  directed_graph_utils::Graph graph(1, 0);
+  graph.addVertex('Z');
+  log_utils::set_sink(saved);
+  EXPECT_EQ(messages > 0, log_utils::kEnabled);
 }
\ No newline at end of file
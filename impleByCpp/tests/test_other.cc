@@ -109,3 +109,20 @@ TEST(SKIP_TEST, EMPTY_CLEAR) {
   EXPECT_FALSE(skipList.empty());
   skipList.clear();
 }
+
+TEST(SKIP_TEST, MERGE_RANGE_QUERIES) {
+  SkipList<int, std::string> shard1, shard2, shard3;
+  shard1.insert(1, "a1");
+  shard1.insert(4, "a4");
+  shard1.insert(9, "a9");
+  shard2.insert(2, "b2");
+  shard2.insert(4, "b4");
+  shard3.insert(3, "c3");
+  shard3.insert(8, "c8");
+
+  auto merged = mergeRangeQueries<int, std::string>(
+      {&shard1, &shard2, &shard3}, 2, 8);
+  std::vector<std::pair<int, std::string>> expected{
+      {2, "b2"}, {3, "c3"}, {4, "a4"}, {4, "b4"}, {8, "c8"}};
+  EXPECT_EQ(merged, expected);
+}
@@ -0,0 +1,235 @@
+#include "core_api/search_utils.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+static std::vector<int> sorted_ints(std::size_t n, int max_value,
+                                    unsigned seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(0, max_value);
+  std::vector<int> list(n);
+  for (auto &x : list)
+    x = dist(rng);
+  std::sort(list.begin(), list.end());
+  return list;
+}
+
+TEST(SearchTest, classic_search) {
+  std::vector<int> list{1, 3, 5, 7, 9, 11, 13};
+  EXPECT_EQ(linearSearch(list, 7), 3);
+  EXPECT_EQ(binarySearch(list, 11), 5);
+  EXPECT_EQ(fibonacciSearch(list, 1), 0);
+  EXPECT_EQ(interpolationSearch(list, 13), 6);
+  EXPECT_EQ(binarySearch(list, 4), -1);
+}
+
+TEST(SearchTest, eytzinger_index) {
+  // 覆盖各种不满的最后一层, 值域小以产生大量重复
+  for (std::size_t n = 0; n <= 130; ++n) {
+    auto list = sorted_ints(n, static_cast<int>(n / 2), n);
+    SearchUtils::EytzingerIndex<int> index(list);
+    ASSERT_EQ(index.size(), n);
+    for (int x = -1; x <= static_cast<int>(n / 2) + 1; ++x) {
+      auto lo = std::lower_bound(list.begin(), list.end(), x) - list.begin();
+      auto hi = std::upper_bound(list.begin(), list.end(), x) - list.begin();
+      ASSERT_EQ(index.lower_bound(x), lo) << "n=" << n << " x=" << x;
+      ASSERT_EQ(index.upper_bound(x), hi) << "n=" << n << " x=" << x;
+      ASSERT_EQ(index.contains(x), lo != hi);
+    }
+  }
+
+  auto list = sorted_ints(1 << 20, 1 << 30, 7);
+  SearchUtils::EytzingerIndex<int> index(list.begin(), list.end());
+  std::mt19937 rng(8);
+  for (int i = 0; i < 10000; ++i) {
+    int x = static_cast<int>(rng() >> 1);
+    ASSERT_EQ(index.lower_bound(x),
+              std::lower_bound(list.begin(), list.end(), x) - list.begin());
+  }
+
+  // 自定义比较器: 降序
+  std::vector<int> desc{9, 7, 7, 5, 3};
+  SearchUtils::EytzingerIndex<int, std::greater<>> rindex(desc);
+  EXPECT_EQ(rindex.lower_bound(7), 1);
+  EXPECT_EQ(rindex.upper_bound(7), 3);
+  EXPECT_EQ(rindex.lower_bound(1), 5);
+  EXPECT_FALSE(rindex.contains(4));
+}
+
+TEST(SearchTest, batch_search) {
+  for (std::size_t n : {0, 1, 2, 3, 17, 1000, 65537}) {
+    auto list = sorted_ints(n, static_cast<int>(n), 11);
+    // 查询个数不是分组大小的整数倍
+    auto keys = sorted_ints(101, static_cast<int>(n) + 2, 12);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(13));
+    std::vector<std::size_t> out(keys.size());
+    SearchUtils::lower_bound_batch(list, keys, out);
+    std::vector<int> found(keys.size());
+    binarySearch(list, keys, found);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      auto lo = std::lower_bound(list.begin(), list.end(), keys[i]);
+      ASSERT_EQ(out[i], lo - list.begin()) << "n=" << n << " i=" << i;
+      if (lo != list.end() && *lo == keys[i])
+        ASSERT_EQ(list[found[i]], keys[i]);
+      else
+        ASSERT_EQ(found[i], -1);
+    }
+  }
+}
+
+TEST(SearchTest, simd_search) {
+  std::mt19937 rng(21);
+  for (std::size_t n : {0, 1, 7, 8, 31, 32, 33, 100, 128, 129, 300, 5000,
+                        100000}) {
+    auto list = sorted_ints(n, static_cast<int>(n), static_cast<unsigned>(n));
+    std::uniform_int_distribution<int> dist(-1, static_cast<int>(n) + 1);
+    for (int q = 0; q < 200; ++q) {
+      int x = dist(rng);
+      auto lo = std::lower_bound(list.begin(), list.end(), x) - list.begin();
+      ASSERT_EQ(SearchUtils::simd_lower_bound(list.data(), n, x), lo)
+          << "n=" << n << " x=" << x;
+      ASSERT_EQ(SearchUtils::detail::simd_lower_bound_scalar(list.data(), n, x),
+                lo);
+      auto first = std::find(list.begin(), list.end(), x) - list.begin();
+      ASSERT_EQ(SearchUtils::simd_find(list.data(), n, x), first);
+      ASSERT_EQ(SearchUtils::detail::simd_find_scalar(list.data(), n, x),
+                first);
+    }
+  }
+  // 无序数组线性查找返回第一次出现的位置
+  std::vector<int> list{5, 9, 2, 9, 7, 1, 3, 8, 6, 4, 0, 2, 11, 13, 17, 19,
+                        23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79,
+                        83, 89, 97, 101};
+  EXPECT_EQ(linearSearch(list, 9), 1);
+  EXPECT_EQ(linearSearch(list, 101), 33);
+  EXPECT_EQ(linearSearch(list, 100), -1);
+}
+
+TEST(SearchTest, static_btree) {
+  // 覆盖1到4层以及各种补齐情况, 值域小以产生大量重复
+  for (std::size_t n : {0, 1, 15, 16, 17, 100, 272, 273, 289, 1000, 4913,
+                        5000, 100000}) {
+    auto list =
+        sorted_ints(n, static_cast<int>(n / 3), static_cast<unsigned>(n));
+    SearchUtils::StaticBTree tree(list);
+    ASSERT_EQ(tree.size(), n);
+    ASSERT_TRUE(std::equal(tree.begin(), tree.end(), list.begin(), list.end()));
+    for (int x = -1; x <= static_cast<int>(n / 3) + 1; ++x) {
+      auto lo = std::lower_bound(list.begin(), list.end(), x) - list.begin();
+      auto hi = std::upper_bound(list.begin(), list.end(), x) - list.begin();
+      ASSERT_EQ(tree.lower_bound(x), lo) << "n=" << n << " x=" << x;
+      ASSERT_EQ(SearchUtils::detail::static_btree_lower_bound_scalar(tree, x),
+                lo);
+      ASSERT_EQ(tree.upper_bound(x), hi);
+      ASSERT_EQ(tree.contains(x), lo != hi);
+      ASSERT_EQ(tree.range(x, x + 2).size(),
+                std::upper_bound(list.begin(), list.end(), x + 1) -
+                    list.begin() - lo);
+    }
+  }
+
+  // 取值包含 INT_MAX 与 INT_MIN(与补齐值相同)
+  std::vector<int> edge{INT_MIN, INT_MIN, -5, 0, 7, INT_MAX, INT_MAX};
+  SearchUtils::StaticBTree tree(edge);
+  EXPECT_EQ(tree.lower_bound(INT_MIN), 0);
+  EXPECT_EQ(tree.lower_bound(INT_MAX), 5);
+  EXPECT_EQ(tree.upper_bound(INT_MAX), 7);
+  EXPECT_TRUE(tree.contains(INT_MAX));
+  EXPECT_EQ(tree.range(-5, 8).size(), 3);
+  EXPECT_TRUE(tree.range(8, -5).empty());
+
+  SearchUtils::StaticBTree moved = std::move(tree);
+  EXPECT_EQ(moved.size(), 7);
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.lower_bound(0), 0);
+}
+
+TEST(SearchTest, interpolation_overflow) {
+  // 跨越整个 int 值域, 原先 (target - arr[left]) * (right - left) 会溢出
+  std::vector<int> list{INT_MIN, -1000, 0, 1000, INT_MAX - 1, INT_MAX};
+  for (std::size_t i = 0; i < list.size(); ++i)
+    EXPECT_EQ(interpolationSearch(list, list[i]), i);
+  EXPECT_EQ(interpolationSearch(list, 1), -1);
+  // 全部相等时不再除以0
+  std::vector<int> same(5, 3);
+  EXPECT_EQ(interpolationSearch(same, 3), 0);
+  EXPECT_EQ(interpolationSearch(same, 4), -1);
+}
+
+TEST(SearchTest, learned_index) {
+  auto check = [](const std::vector<int> &list, int x) {
+    SearchUtils::PgmIndex<int, 8, 2> index(list);
+    auto lo = std::lower_bound(list.begin(), list.end(), x) - list.begin();
+    auto hi = std::upper_bound(list.begin(), list.end(), x) - list.begin();
+    ASSERT_EQ(index.lower_bound(x), lo) << "n=" << list.size() << " x=" << x;
+    ASSERT_EQ(index.upper_bound(x), hi);
+    ASSERT_EQ(index.contains(x), lo != hi);
+    SearchUtils::PgmIndex<int> coarse(list);
+    ASSERT_EQ(coarse.lower_bound(x), lo);
+    ASSERT_EQ(interpolationSearch(coarse, x) != -1, lo != hi);
+  };
+  // 小值域产生大量重复, 小误差产生多段多层
+  for (std::size_t n : {0, 1, 2, 9, 100, 1000, 20000}) {
+    auto list =
+        sorted_ints(n, static_cast<int>(n / 3), static_cast<unsigned>(n));
+    for (int x = -1; x <= static_cast<int>(n / 3) + 1; ++x)
+      check(list, x);
+  }
+
+  // 偏斜分布: 大部分键挤在很小的范围内, 少数键分布在整个值域
+  std::mt19937 rng(31);
+  std::vector<int> skewed = sorted_ints(5000, 100, 32);
+  for (int i = 0; i < 50; ++i)
+    skewed.push_back(static_cast<int>(rng() >> 1));
+  skewed.push_back(INT_MIN);
+  skewed.push_back(INT_MAX);
+  std::sort(skewed.begin(), skewed.end());
+  SearchUtils::PgmIndex<int, 8, 2> index(skewed);
+  SearchUtils::PgmIndex<int> coarse(skewed);
+  for (int x : skewed) {
+    ASSERT_EQ(index.lower_bound(x),
+              std::lower_bound(skewed.begin(), skewed.end(), x) -
+                  skewed.begin());
+    ASSERT_EQ(interpolationSearch(coarse, x), index.lower_bound(x));
+  }
+  for (int i = 0; i < 2000; ++i) {
+    int x = static_cast<int>(rng());
+    ASSERT_EQ(index.lower_bound(x),
+              std::lower_bound(skewed.begin(), skewed.end(), x) -
+                  skewed.begin());
+  }
+  EXPECT_EQ(index.lower_bound(INT_MIN), 0);
+  EXPECT_EQ(index.upper_bound(INT_MAX), skewed.size());
+
+  // 近似等间隔的64位时间戳只需很少的段
+  std::vector<std::int64_t> stamps(1 << 20);
+  std::int64_t t = 1'700'000'000'000'000;
+  for (auto &s : stamps)
+    s = t += 1000 + static_cast<std::int64_t>(rng() % 16);
+  SearchUtils::PgmIndex<std::int64_t> ts_index(stamps);
+  EXPECT_LT(ts_index.segments(), 64);
+  EXPECT_LT(ts_index.size_in_bytes(), 4096);
+  for (int i = 0; i < 10000; ++i) {
+    std::int64_t x = stamps.front() - 5000 +
+                     static_cast<std::int64_t>(rng() % (1000 * stamps.size()));
+    ASSERT_EQ(ts_index.lower_bound(x),
+              std::lower_bound(stamps.begin(), stamps.end(), x) -
+                  stamps.begin());
+  }
+
+  SearchUtils::PgmIndex<int> empty;
+  EXPECT_EQ(empty.lower_bound(0), 0);
+  EXPECT_FALSE(empty.contains(0));
+
+  // 索引不持有数据: 可由左值容器或 span 构建, 不能由临时容器构建
+  using Index = SearchUtils::PgmIndex<int>;
+  static_assert(std::is_constructible_v<Index, const std::vector<int> &>);
+  static_assert(std::is_constructible_v<Index, std::span<const int>>);
+  static_assert(!std::is_constructible_v<Index, std::vector<int> &&>);
+  static_assert(!std::is_constructible_v<Index, std::vector<int>>);
+}
@@ -12,39 +12,64 @@ BTreeNode *root = create_tree(_vals);
 
 TEST(tree_test, create_tree) { EXPECT_TRUE(root != nullptr); }
 
+// 收集遍历顺序的访问器
+struct Collect {
+  std::vector<NodeVal> &out;
+  void operator()(const BTreeNode *node) const { out.push_back(node->val); }
+};
+
+const std::vector<NodeVal> kPreorder{3, 1, 4, 6, 7, 11, 8, 5, 2};
+const std::vector<NodeVal> kInorder{6, 4, 1, 7, 11, 3, 5, 8, 2};
+const std::vector<NodeVal> kPostorder{6, 4, 11, 7, 1, 5, 2, 8, 3};
+
 TEST(tree_test, preorderTraversal) {
-  std::cout << "Preorder Traversal: ";
-  EXPECT_FALSE(!preorderTraversal(root));
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(preorderTraversal(root, Collect{order}));
+  EXPECT_EQ(order, kPreorder);
 }
 
 TEST(tree_test, inorderTraversal) {
-  std::cout << "Inorder Traversal: ";
-  EXPECT_FALSE(!inorderTraversal(root));
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(inorderTraversal(root, Collect{order}));
+  EXPECT_EQ(order, kInorder);
 }
 
 TEST(tree_test, postorderTraversal) {
-  std::cout << "Postorder Traversal: ";
-  EXPECT_FALSE(!postorderTraversal(root));
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(postorderTraversal(root, Collect{order}));
+  EXPECT_EQ(order, kPostorder);
 }
 
 TEST(tree_test, levelorderTraversal) {
-  std::cout << "Levelorder Traversal: ";
-  EXPECT_TRUE(levelorderTraversal(root));
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(levelorderTraversal(root, Collect{order}));
+  EXPECT_EQ(order, (std::vector<NodeVal>{3, 1, 8, 4, 7, 5, 2, 6, 11}));
+  EXPECT_FALSE(levelorderTraversal(nullptr, Collect{order}));
+  EXPECT_TRUE(levelorderTraversal(root, nullptr));
 }
 
 TEST(tree_test, norecursion_preorderTraversal) {
-  std::cout << "No recursion Preorder Traversal: ";
-  EXPECT_TRUE(norecursion_preorderTraversal(root));
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(norecursion_preorderTraversal(root, Collect{order}));
+  EXPECT_EQ(order, kPreorder);
 }
 
 TEST(tree_test, norecursion_inorderTraversal) {
-  std::cout << "No recursion Inorder Traversal: ";
-  EXPECT_TRUE(norecursion_inorderTraversal(root));
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(norecursion_inorderTraversal(root, Collect{order}));
+  EXPECT_EQ(order, kInorder);
 }
 
 TEST(tree_test, norecursion_postorderTraversal) {
-  std::cout << "No recursion Postorder Traversal: ";
-  EXPECT_TRUE(norecursion_postorderTraversal(root));
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(norecursion_postorderTraversal(root, Collect{order}));
+  EXPECT_EQ(order, kPostorder);
+}
+
+TEST(tree_test, print_visitor) {
+  testing::internal::CaptureStdout();
+  preorderTraversal(root, PrintVisitor{});
+  EXPECT_EQ(testing::internal::GetCapturedStdout(), "3 1 4 6 7 11 8 5 2 ");
 }
 
 TEST(tree_test, height) { EXPECT_EQ(4, height(root)); }
@@ -152,8 +177,9 @@ TEST(BST_test, bst_tree_inorder) {
   std::vector<NodeVal> vals{3, 1, 8, 4, 7, 5, 2, 6, 10, 7};
   binary_tree::binary_search_tree::BST bst;
   bst.createTree(vals);
-  bool res = binary_tree::inorderTraversal(bst.getRoot());
-  EXPECT_TRUE(res);
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(binary_tree::inorderTraversal(bst.getRoot(), Collect{order}));
+  EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
 }
 
 TEST(BST_test, bst_tree_remove) {
@@ -161,8 +187,10 @@ TEST(BST_test, bst_tree_remove) {
   binary_tree::binary_search_tree::BST bst;
   bst.createTree(vals);
   bst.remove(10);
-  bool res = binary_tree::inorderTraversal(bst.getRoot());
-  EXPECT_TRUE(res);
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(binary_tree::inorderTraversal(bst.getRoot(), Collect{order}));
+  EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+  EXPECT_EQ(std::count(order.begin(), order.end(), 10), 0);
 }
 
 TEST(BST_test, bst_tree_search) {
@@ -177,8 +205,10 @@ TEST(BST_test, bst_tree_insert) {
   binary_tree::binary_search_tree::BST bst;
   bst.createTree(vals);
   bst.insert(9);
-  bool res = binary_tree::inorderTraversal(bst.getRoot());
-  EXPECT_TRUE(res);
+  std::vector<NodeVal> order;
+  EXPECT_TRUE(binary_tree::inorderTraversal(bst.getRoot(), Collect{order}));
+  EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+  EXPECT_EQ(std::count(order.begin(), order.end(), 9), 1);
 }
 
 TEST(BST_test, bst_tree_successor) {